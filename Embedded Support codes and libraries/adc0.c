@@ -10,7 +10,14 @@
 // System Clock:    -
 
 // Hardware configuration:
-// ADC0 SS3
+// ADC0 SS0-SS3
+
+// Hook in adc0SsNIsr to the ADC0 Sequence N IVT entry of each sequence started with initAdc0Ss
+// Acquisition uses TIMER0A as the trigger and uDMA channels 14-17 (SS0-SS3)
+// Digital comparator interrupts arrive on the vector of the sequence feeding the comparator
+// Comparator triggers go to the PWM fault logic; to shut down a PWM generator on a
+//   comparator event, set FLTSRC in its PWMn_x_CTL register and the DCMPn bit in
+//   its PWMn_x_FLTSRC1 register
 
 //-----------------------------------------------------------------------------
 // Device includes, defines, and assembler directives
@@ -19,14 +26,86 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "tm4c123gh6pm.h"
+#include "nvic.h"
+#include "udma.h"
 #include "adc0.h"
 
 #define ADC_CTL_DITHER          0x00000040
 
+// Sample sequencer registers (n = 0-3) are spaced 0x20 apart from SS0
+#define ADC0_SSMUX(n)   (*((volatile uint32_t *)(0x40038040 + 0x20 * (n))))
+#define ADC0_SSCTL(n)   (*((volatile uint32_t *)(0x40038044 + 0x20 * (n))))
+#define ADC0_SSFIFO(n)  (*((volatile uint32_t *)(0x40038048 + 0x20 * (n))))
+#define ADC0_SSFSTAT(n) (*((volatile uint32_t *)(0x4003804C + 0x20 * (n))))
+#define ADC0_SSOP(n)    (*((volatile uint32_t *)(0x40038050 + 0x20 * (n))))
+#define ADC0_SSDC(n)    (*((volatile uint32_t *)(0x40038054 + 0x20 * (n))))
+
+// Digital comparator registers (n = 0-7)
+#define ADC0_DCCTL(n)   (*((volatile uint32_t *)(0x40038E00 + 4 * (n))))
+#define ADC0_DCCMP(n)   (*((volatile uint32_t *)(0x40038E40 + 4 * (n))))
+
+// SSCTL bits of step i
+#define SSCTL_END(i)    (0x2 << (4 * (i)))
+#define SSCTL_IE(i)     (0x4 << (4 * (i)))
+
+// SSOP and SSDC fields of step i
+#define SSOP_DCOP(i)    (0x1 << (4 * (i)))
+#define SSDC_DCSEL_M(i) (0xF << (4 * (i)))
+
+#define ADC0_RING_MASK (ADC0_RING_SIZE - 1)
+
+// SSn is requested on uDMA channel 14+n, encoding 0
+#define ADC0_DMA_CHANNEL(n) (14 + (n))
+
+#define ADC0_DMA_CONTROL (UDMA_CHCTL_DSTINC_16 | UDMA_CHCTL_DSTSIZE_16 | \
+                          UDMA_CHCTL_SRCINC_NONE | UDMA_CHCTL_SRCSIZE_16 | \
+                          UDMA_CHCTL_XFERMODE_PINGPONG)
+
+// Run-time state of each sequence
+// Each step ring has a single writer (the isr) and a single reader (the application)
+typedef struct _ADC0_SEQUENCE
+{
+    uint8_t count;
+    uint16_t ring[ADC0_MAX_STEPS][ADC0_RING_SIZE];
+    volatile uint8_t writeIndex[ADC0_MAX_STEPS];
+    volatile uint8_t readIndex[ADC0_MAX_STEPS];
+    volatile uint16_t latest[ADC0_MAX_STEPS];
+    volatile uint32_t overflowCount;
+    ADC0_CALLBACK callback;
+    uint8_t comparatorSteps;       // steps routed to a comparator instead of the fifo
+} ADC0_SEQUENCE;
+
+// Run-time state of each digital comparator
+typedef struct _ADC0_COMPARATOR
+{
+    bool routed;
+    uint8_t ss;
+    uint8_t step;
+    ADC0_COMPARATOR_CALLBACK callback;
+    volatile uint32_t eventCount;
+} ADC0_COMPARATOR;
+
 //-----------------------------------------------------------------------------
 // Global variables
 //-----------------------------------------------------------------------------
 
+const uint8_t adc0SsDepth[4] = {8, 4, 4, 1};
+const uint8_t adc0SsVector[4] = {INT_ADC0SS0, INT_ADC0SS1, INT_ADC0SS2, INT_ADC0SS3};
+ADC0_SEQUENCE adc0Sequence[4];
+ADC0_COMPARATOR adc0Comparator[ADC0_COMPARATOR_COUNT];
+
+// Acquisition state
+// Buffers are filled in ping-pong order; dmaActive is the structure being filled
+bool adc0Acquiring = false;
+uint8_t adc0AcquisitionSs;
+uint16_t* adc0DmaBuffer[2];
+uint16_t adc0DmaSize;
+uint32_t adc0DmaControl;
+volatile uint8_t adc0DmaActive;
+ADC0_BLOCK_CALLBACK adc0BlockCallback;
+volatile uint32_t adc0BlockCount;
+volatile uint32_t adc0OverrunCount;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -75,3 +154,462 @@ int16_t readAdc0Ss3()
     while (ADC0_SSFSTAT3_R & ADC_SSFSTAT3_EMPTY);
     return ADC0_SSFIFO3_R;                           // get single result from the FIFO
 }
+
+// Configures a sequence to sample count inputs with a completion interrupt
+// The sequence is processor triggered; call startAdc0Ss for each conversion
+// Returns false if count is 0 or exceeds the sequence depth, or if the sequence
+// is being acquired (stop the acquisition first)
+bool initAdc0Ss(uint8_t ss, const uint8_t inputs[], uint8_t count)
+{
+    ADC0_SEQUENCE* s = &adc0Sequence[ss];
+    uint32_t mux = 0;
+    uint8_t i;
+    if (ss > 3 || count == 0 || count > adc0SsDepth[ss])
+        return false;
+    if (adc0Acquiring && ss == adc0AcquisitionSs)
+        return false;
+
+    // Enable clocks
+    SYSCTL_RCGCADC_R |= SYSCTL_RCGCADC_R0;
+    _delay_cycles(16);
+
+    // Configure ADC
+    ADC0_ACTSS_R &= ~(ADC_ACTSS_ASEN0 << ss);        // disable sequence for programming
+    ADC0_CC_R = ADC_CC_CS_SYSPLL;                    // select PLL as the time base (not needed, since default value)
+    ADC0_PC_R = ADC_PC_SR_1M;                        // select 1Msps rate
+    ADC0_EMUX_R &= ~(ADC_EMUX_EM0_M << (4 * ss));    // select PSSI as trigger
+    for (i = 0; i < count; i++)
+        mux |= (uint32_t)(inputs[i] & 0xF) << (4 * i);
+    ADC0_SSMUX(ss) = mux;
+    ADC0_SSCTL(ss) = SSCTL_END(count - 1) | SSCTL_IE(count - 1);
+                                                     // interrupt at the end of the last step
+    ADC0_SSOP(ss) = 0;                               // all steps to the fifo
+    for (i = 0; i < ADC0_COMPARATOR_COUNT; i++)
+        if (adc0Comparator[i].routed && adc0Comparator[i].ss == ss)
+        {
+            ADC0_DCCTL(i) = 0;
+            adc0Comparator[i].routed = false;
+        }
+    ADC0_IM_R &= ~(ADC_IM_DCONSS0 << ss);
+
+    // Empty rings
+    s->count = count;
+    for (i = 0; i < ADC0_MAX_STEPS; i++)
+    {
+        s->writeIndex[i] = s->readIndex[i] = 0;
+        s->latest[i] = 0;
+    }
+    s->overflowCount = 0;
+    s->callback = 0;
+    s->comparatorSteps = 0;
+
+    // Configure interrupts
+    ADC0_ISC_R = ADC_ISC_IN0 << ss;
+    ADC0_IM_R |= ADC_IM_MASK0 << ss;
+    enableNvicInterrupt(adc0SsVector[ss]);
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0 << ss;           // enable sequence for operation
+    return true;
+}
+
+// Set input sample average count (shared by all sequences)
+void setAdc0SsLog2AverageCount(uint8_t log2AverageCount)
+{
+    ADC0_SAC_R = log2AverageCount;                   // sample HW averaging
+    if (log2AverageCount == 0)
+        ADC0_CTL_R &= ~ADC_CTL_DITHER;               // turn-off dithering if no averaging
+    else
+        ADC0_CTL_R |= ADC_CTL_DITHER;                // turn-on dithering if averaging
+}
+
+// Non-blocking function that requests one conversion of the whole sequence
+void startAdc0Ss(uint8_t ss)
+{
+    ADC0_PSSI_R = ADC_PSSI_SS0 << ss;
+}
+
+// Called from the isr after each sequence completes
+void setAdc0SsCallback(uint8_t ss, ADC0_CALLBACK callback)
+{
+    adc0Sequence[ss].callback = callback;
+}
+
+// Most recent sample of a step, whether or not it has been read
+uint16_t getAdc0SsLatest(uint8_t ss, uint8_t step)
+{
+    return adc0Sequence[ss].latest[step];
+}
+
+// Number of buffered samples of a step
+uint8_t getAdc0SsCount(uint8_t ss, uint8_t step)
+{
+    ADC0_SEQUENCE* s = &adc0Sequence[ss];
+    return (s->writeIndex[step] - s->readIndex[step]) & ADC0_RING_MASK;
+}
+
+// Non-blocking function that returns the oldest buffered sample of a step
+bool readAdc0SsSample(uint8_t ss, uint8_t step, uint16_t* sample)
+{
+    ADC0_SEQUENCE* s = &adc0Sequence[ss];
+    uint8_t readIndex = s->readIndex[step];
+    if (readIndex == s->writeIndex[step])
+        return false;
+    *sample = s->ring[step][readIndex];
+    s->readIndex[step] = (readIndex + 1) & ADC0_RING_MASK;
+    return true;
+}
+
+// Non-blocking function that returns up to size buffered samples of a step, oldest first
+uint8_t readAdc0SsSamples(uint8_t ss, uint8_t step, uint16_t samples[], uint8_t size)
+{
+    uint8_t count = 0;
+    while (count < size && readAdc0SsSample(ss, step, &samples[count]))
+        count++;
+    return count;
+}
+
+// Samples discarded by the isr because a step ring was full
+uint32_t getAdc0SsOverflowCount(uint8_t ss)
+{
+    return adc0Sequence[ss].overflowCount;
+}
+
+// Samples a sequence configured with initAdc0Ss on every TIMER0A timeout
+// The uDMA moves each sequence of samples from the fifo into buffer0 then buffer1 and so on,
+// and the callback is called from the isr with each full buffer while the other fills
+// The callback must finish before the other buffer fills (size / sample rate)
+// The number of steps must be 1, 2, 4 or 8 (one uDMA burst per sequence) and must
+// divide size; sequenceRate * steps must not exceed 1Msps
+// initUdma() must be called first
+bool startAdc0Acquisition(uint8_t ss, uint32_t sequenceRate, uint32_t fcyc,
+                          uint16_t buffer0[], uint16_t buffer1[], uint16_t size,
+                          ADC0_BLOCK_CALLBACK callback)
+{
+    uint8_t count, channel;
+    uint32_t arbSize;
+    if (adc0Acquiring || ss > 3 || sequenceRate == 0 || size == 0 || size > UDMA_MAX_TRANSFER)
+        return false;
+    count = adc0Sequence[ss].count;
+    channel = ADC0_DMA_CHANNEL(ss);
+    switch (count)
+    {
+        case 1: arbSize = UDMA_CHCTL_ARBSIZE_1; break;
+        case 2: arbSize = UDMA_CHCTL_ARBSIZE_2; break;
+        case 4: arbSize = UDMA_CHCTL_ARBSIZE_4; break;
+        case 8: arbSize = UDMA_CHCTL_ARBSIZE_8; break;
+        default: return false;                       // also rejects a sequence not yet initialized
+    }
+    if ((size % count) != 0 || sequenceRate > ADC0_MAX_SAMPLE_RATE / count)
+        return false;
+    if (adc0Sequence[ss].comparatorSteps != 0)
+        return false;                                // fewer samples than steps reach the fifo
+
+    adc0AcquisitionSs = ss;
+    adc0DmaBuffer[0] = buffer0;
+    adc0DmaBuffer[1] = buffer1;
+    adc0DmaSize = size;
+    adc0DmaControl = ADC0_DMA_CONTROL | arbSize;
+    adc0DmaActive = 0;
+    adc0BlockCallback = callback;
+    adc0BlockCount = 0;
+    adc0OverrunCount = 0;
+    adc0Acquiring = true;
+
+    // Only the uDMA done interrupt is wanted, so the sequence interrupt is masked
+    ADC0_ACTSS_R &= ~(ADC_ACTSS_ASEN0 << ss);        // disable sequence for programming
+    ADC0_IM_R &= ~(ADC_IM_MASK0 << ss);
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~(ADC_EMUX_EM0_M << (4 * ss))) | (ADC_EMUX_EM0_TIMER << (4 * ss));
+    while (!(ADC0_SSFSTAT(ss) & ADC_SSFSTAT0_EMPTY))
+        ADC0_SSFIFO(ss);                             // discard stale samples
+
+    // Load both structures
+    selectUdmaChannelEncoding(channel, 0);
+    setUdmaChannelBurstOnly(channel, true);
+    setUdmaChannelTransfer(channel, UDMA_PRIMARY, &ADC0_SSFIFO(ss), buffer0, adc0DmaControl, size);
+    setUdmaChannelTransfer(channel, UDMA_ALTERNATE, &ADC0_SSFIFO(ss), buffer1, adc0DmaControl, size);
+    selectUdmaChannelStructure(channel, UDMA_PRIMARY);
+    enableUdmaChannel(channel);
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0 << ss;           // enable sequence for operation
+
+    // Configure TIMER0A as the trigger
+    SYSCTL_RCGCTIMER_R |= SYSCTL_RCGCTIMER_R0;
+    _delay_cycles(3);
+    TIMER0_CTL_R &= ~TIMER_CTL_TAEN;                 // turn-off timer before reconfiguring
+    TIMER0_CFG_R = TIMER_CFG_32_BIT_TIMER;           // configure as 32-bit timer (A+B)
+    TIMER0_TAMR_R = TIMER_TAMR_TAMR_PERIOD;          // configure for periodic mode (count down)
+    TIMER0_TAILR_R = fcyc / sequenceRate - 1;        // set load value for the sequence rate
+    TIMER0_IMR_R = 0;                                // no timer interrupts, only the adc trigger
+    TIMER0_CTL_R |= TIMER_CTL_TAOTE | TIMER_CTL_TAEN;
+                                                     // turn-on trigger output and timer
+    return true;
+}
+
+// Stops the timer and the uDMA; the sequence is returned to processor triggering
+void stopAdc0Acquisition()
+{
+    uint8_t ss = adc0AcquisitionSs;
+    if (!adc0Acquiring)
+        return;
+    TIMER0_CTL_R &= ~(TIMER_CTL_TAOTE | TIMER_CTL_TAEN);
+    disableUdmaChannel(ADC0_DMA_CHANNEL(ss));
+    ADC0_ACTSS_R &= ~(ADC_ACTSS_ASEN0 << ss);
+    ADC0_EMUX_R &= ~(ADC_EMUX_EM0_M << (4 * ss));
+    ADC0_ISC_R = ADC_ISC_IN0 << ss;
+    ADC0_IM_R |= ADC_IM_MASK0 << ss;
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0 << ss;
+    adc0Acquiring = false;
+}
+
+bool isAdc0AcquisitionRunning()
+{
+    return adc0Acquiring;
+}
+
+// Number of buffers passed to the callback
+uint32_t getAdc0AcquisitionBlockCount()
+{
+    return adc0BlockCount;
+}
+
+// Number of times both buffers were found full (a callback ran too long)
+uint32_t getAdc0AcquisitionOverrunCount()
+{
+    return adc0OverrunCount;
+}
+
+// Hands full buffers to the callback and reloads their structures
+void processAdc0Acquisition()
+{
+    uint8_t channel = ADC0_DMA_CHANNEL(adc0AcquisitionSs);
+    volatile uint32_t* fifo = &ADC0_SSFIFO(adc0AcquisitionSs);
+    uint8_t active;
+    clearUdmaChannelInterrupt(channel);
+    if (isUdmaTransferDone(channel, adc0DmaActive ^ 1) && isUdmaTransferDone(channel, adc0DmaActive))
+        adc0OverrunCount++;
+    while (isUdmaTransferDone(channel, adc0DmaActive))
+    {
+        active = adc0DmaActive;
+        adc0DmaActive ^= 1;
+        setUdmaChannelTransfer(channel, active, fifo, adc0DmaBuffer[active], adc0DmaControl, adc0DmaSize);
+        adc0BlockCount++;
+        if (adc0BlockCallback)
+            adc0BlockCallback(adc0DmaBuffer[active], adc0DmaSize);
+    }
+    // Both structures stopped, so the channel disabled itself
+    if (!isUdmaChannelEnabled(channel))
+    {
+        selectUdmaChannelStructure(channel, adc0DmaActive);
+        enableUdmaChannel(channel);
+    }
+}
+
+// Digital comparators
+// A comparator monitors one step of a sequence configured with initAdc0Ss; the step
+// can sample any input, and samples of that step no longer reach the fifo
+// Thresholds are 12-bit; the low band is at or below low and the high band is above high
+// Routing a step already routed to another comparator moves it to this one
+// Returns false if the sequence step does not exist, the thresholds are out of order,
+// or the sequence is used for acquisition
+bool initAdc0Comparator(uint8_t comparator, uint8_t ss, uint8_t step, uint16_t low, uint16_t high)
+{
+    ADC0_SEQUENCE* s = &adc0Sequence[ss];
+    ADC0_COMPARATOR* c = &adc0Comparator[comparator];
+    uint8_t i;
+    if (comparator >= ADC0_COMPARATOR_COUNT || ss > 3 || step >= s->count || low > high || high > 4095)
+        return false;
+    if (adc0Acquiring && ss == adc0AcquisitionSs)
+        return false;
+    if (c->routed)
+        disableAdc0Comparator(comparator);
+    for (i = 0; i < ADC0_COMPARATOR_COUNT; i++)
+        if (adc0Comparator[i].routed && adc0Comparator[i].ss == ss && adc0Comparator[i].step == step)
+            disableAdc0Comparator(i);
+
+    ADC0_ACTSS_R &= ~(ADC_ACTSS_ASEN0 << ss);        // disable sequence for programming
+    ADC0_DCCTL(comparator) = 0;                      // no interrupt or trigger until enabled
+    ADC0_DCCMP(comparator) = ((uint32_t)high << ADC_DCCMP0_COMP1_S) | low;
+    ADC0_DCRIC_R = (ADC_DCRIC_DCTRIG0 | ADC_DCRIC_DCINT0) << comparator;
+    ADC0_SSDC(ss) = (ADC0_SSDC(ss) & ~SSDC_DCSEL_M(step)) | ((uint32_t)comparator << (4 * step));
+    ADC0_SSOP(ss) |= SSOP_DCOP(step);
+    s->comparatorSteps |= 1 << step;
+    // With no samples left for the fifo, the sequence interrupt has nothing to do
+    if (s->comparatorSteps == (1 << s->count) - 1)
+        ADC0_IM_R &= ~(ADC_IM_MASK0 << ss);
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0 << ss;           // enable sequence for operation
+
+    c->routed = true;
+    c->ss = ss;
+    c->step = step;
+    c->callback = 0;
+    c->eventCount = 0;
+    return true;
+}
+
+// Calls the callback from the isr when a sample matches the band and mode
+// Returns false if the comparator is not initialized or the mode needs the low or high band
+bool enableAdc0ComparatorInterrupt(uint8_t comparator, ADC0_BAND band, ADC0_COMPARE_MODE mode,
+                                   ADC0_COMPARATOR_CALLBACK callback)
+{
+    ADC0_COMPARATOR* c = &adc0Comparator[comparator];
+    if (comparator >= ADC0_COMPARATOR_COUNT || !c->routed)
+        return false;
+    if (band == ADC0_BAND_MID && mode >= ADC0_COMPARE_HYSTERESIS_ALWAYS)
+        return false;
+    c->callback = callback;
+    ADC0_DCRIC_R = ADC_DCRIC_DCINT0 << comparator;
+    ADC0_DCISC_R = ADC_DCISC_DCINT0 << comparator;
+    ADC0_DCCTL(comparator) = (ADC0_DCCTL(comparator) & ~(ADC_DCCTL0_CIE | ADC_DCCTL0_CIC_M | ADC_DCCTL0_CIM_M))
+                           | ADC_DCCTL0_CIE | (band << 2) | mode;
+    ADC0_IM_R |= ADC_IM_DCONSS0 << c->ss;
+    enableNvicInterrupt(adc0SsVector[c->ss]);
+    return true;
+}
+
+// Asserts the comparator trigger to the PWM fault logic when a sample matches the band and mode
+// No software runs, so a fault shuts down the PWM within one sample of the crossing
+// Returns false if the comparator is not initialized or the mode needs the low or high band
+bool enableAdc0ComparatorTrigger(uint8_t comparator, ADC0_BAND band, ADC0_COMPARE_MODE mode)
+{
+    if (comparator >= ADC0_COMPARATOR_COUNT || !adc0Comparator[comparator].routed)
+        return false;
+    if (band == ADC0_BAND_MID && mode >= ADC0_COMPARE_HYSTERESIS_ALWAYS)
+        return false;
+    ADC0_DCRIC_R = ADC_DCRIC_DCTRIG0 << comparator;
+    ADC0_DCCTL(comparator) = (ADC0_DCCTL(comparator) & ~(ADC_DCCTL0_CTE | ADC_DCCTL0_CTC_M | ADC_DCCTL0_CTM_M))
+                           | ADC_DCCTL0_CTE | (band << 10) | (mode << 8);
+    return true;
+}
+
+// Clears the interrupt and trigger conditions so once and hysteresis modes are re-armed
+void resetAdc0Comparator(uint8_t comparator)
+{
+    ADC0_DCRIC_R = (ADC_DCRIC_DCTRIG0 | ADC_DCRIC_DCINT0) << comparator;
+}
+
+// Stops the comparator and returns its step to the fifo
+// A continuous sequence returns to processor triggering (see setAdc0SsContinuous)
+void disableAdc0Comparator(uint8_t comparator)
+{
+    ADC0_COMPARATOR* c = &adc0Comparator[comparator];
+    bool interrupts = false;
+    uint8_t i;
+    if (comparator >= ADC0_COMPARATOR_COUNT || !c->routed)
+        return;
+    c->routed = false;
+    ADC0_ACTSS_R &= ~(ADC_ACTSS_ASEN0 << c->ss);     // disable sequence for programming
+    ADC0_DCCTL(comparator) = 0;
+    resetAdc0Comparator(comparator);
+    ADC0_DCISC_R = ADC_DCISC_DCINT0 << comparator;
+    ADC0_SSOP(c->ss) &= ~SSOP_DCOP(c->step);
+    adc0Sequence[c->ss].comparatorSteps &= ~(1 << c->step);
+    ADC0_EMUX_R &= ~(ADC_EMUX_EM0_M << (4 * c->ss)); // select PSSI as trigger
+    ADC0_ISC_R = ADC_ISC_IN0 << c->ss;
+    ADC0_IM_R |= ADC_IM_MASK0 << c->ss;
+    for (i = 0; i < ADC0_COMPARATOR_COUNT; i++)
+        if (adc0Comparator[i].routed && adc0Comparator[i].ss == c->ss && (ADC0_DCCTL(i) & ADC_DCCTL0_CIE))
+            interrupts = true;
+    if (!interrupts)
+        ADC0_IM_R &= ~(ADC_IM_DCONSS0 << c->ss);
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0 << c->ss;        // enable sequence for operation
+}
+
+// Number of comparator interrupts since the comparator was initialized
+uint32_t getAdc0ComparatorEventCount(uint8_t comparator)
+{
+    return adc0Comparator[comparator].eventCount;
+}
+
+// Restarts a sequence as soon as it completes, so comparators monitor without software
+// Use the lowest priority sequence (SS3 by default) so others are still serviced
+// Returns false when enabling unless every step is routed to a comparator, since
+// fifo samples would interrupt at the conversion rate
+bool setAdc0SsContinuous(uint8_t ss, bool enable)
+{
+    ADC0_SEQUENCE* s = &adc0Sequence[ss];
+    if (ss > 3)
+        return false;
+    if (enable && (s->count == 0 || s->comparatorSteps != (1 << s->count) - 1))
+        return false;
+    ADC0_ACTSS_R &= ~(ADC_ACTSS_ASEN0 << ss);        // disable sequence for programming
+    ADC0_EMUX_R &= ~(ADC_EMUX_EM0_M << (4 * ss));
+    if (enable)
+        ADC0_EMUX_R |= ADC_EMUX_EM0_ALWAYS << (4 * ss);
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0 << ss;           // enable sequence for operation
+    return true;
+}
+
+// Calls the callbacks of the comparators fed by a sequence that have interrupted
+void processAdc0Comparators(uint8_t ss)
+{
+    uint32_t status = ADC0_DCISC_R;
+    uint8_t i;
+    for (i = 0; i < ADC0_COMPARATOR_COUNT; i++)
+    {
+        if (!adc0Comparator[i].routed || adc0Comparator[i].ss != ss || !(status & (ADC_DCISC_DCINT0 << i)))
+            continue;
+        ADC0_DCISC_R = ADC_DCISC_DCINT0 << i;
+        adc0Comparator[i].eventCount++;
+        if (adc0Comparator[i].callback)
+            adc0Comparator[i].callback(i);
+    }
+    ADC0_ISC_R = ADC_ISC_DCINSS0 << ss;
+}
+
+// Moves the samples of a completed sequence from the fifo into the step rings
+void adc0SsIsr(uint8_t ss)
+{
+    ADC0_SEQUENCE* s = &adc0Sequence[ss];
+    uint8_t step = 0;
+    uint8_t writeIndex, next;
+    uint16_t sample;
+    if (ADC0_ISC_R & (ADC_ISC_DCINSS0 << ss))
+        processAdc0Comparators(ss);
+    if (adc0Acquiring && ss == adc0AcquisitionSs)
+    {
+        processAdc0Acquisition();
+        return;
+    }
+    if (!(ADC0_ISC_R & (ADC_ISC_IN0 << ss)))
+        return;
+    ADC0_ISC_R = ADC_ISC_IN0 << ss;
+    while (!(ADC0_SSFSTAT(ss) & ADC_SSFSTAT0_EMPTY))
+    {
+        while (s->comparatorSteps & (1 << step))
+            if (++step == s->count)
+                step = 0;
+        sample = ADC0_SSFIFO(ss);
+        s->latest[step] = sample;
+        writeIndex = s->writeIndex[step];
+        next = (writeIndex + 1) & ADC0_RING_MASK;
+        if (next != s->readIndex[step])
+        {
+            s->ring[step][writeIndex] = sample;
+            s->writeIndex[step] = next;
+        }
+        else
+            s->overflowCount++;
+        if (++step == s->count)
+            step = 0;
+    }
+    if (s->callback)
+        s->callback(ss);
+}
+
+void adc0Ss0Isr()
+{
+    adc0SsIsr(0);
+}
+
+void adc0Ss1Isr()
+{
+    adc0SsIsr(1);
+}
+
+void adc0Ss2Isr()
+{
+    adc0SsIsr(2);
+}
+
+void adc0Ss3Isr()
+{
+    adc0SsIsr(3);
+}
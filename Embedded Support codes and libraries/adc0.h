@@ -10,7 +10,7 @@
 // System Clock:    -
 
 // Hardware configuration:
-// ADC0 SS3
+// ADC0 SS0-SS3
 
 //-----------------------------------------------------------------------------
 // Device includes, defines, and assembler directives
@@ -19,6 +19,45 @@
 #ifndef ADC0_H_
 #define ADC0_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADC0_MAX_STEPS 8           // SS0 has 8 steps, SS1 and SS2 have 4, SS3 has 1
+#define ADC0_RING_SIZE 16          // samples buffered per step (power of 2)
+
+#define ADC0_MAX_SAMPLE_RATE 1000000
+
+#define ADC0_COMPARATOR_COUNT 8
+
+typedef void (*ADC0_CALLBACK)(uint8_t ss);
+typedef void (*ADC0_BLOCK_CALLBACK)(const uint16_t samples[], uint16_t size);
+typedef void (*ADC0_COMPARATOR_CALLBACK)(uint8_t comparator);
+
+// Digital comparator bands (values match the CIC/CTC fields)
+//   Low band is at or below the low threshold, high band is above the high threshold
+typedef enum _ADC0_BAND
+{
+    ADC0_BAND_LOW = 0,
+    ADC0_BAND_MID = 1,
+    ADC0_BAND_HIGH = 3
+} ADC0_BAND;
+
+// Digital comparator event modes (values match the CIM/CTM fields)
+//   ALWAYS: every sample in the band
+//   ONCE: the first sample entering the band
+//   HYSTERESIS_ALWAYS: every sample in the band, and in the mid band until the
+//     opposite band is reached
+//   HYSTERESIS_ONCE: the first sample entering the band, re-armed only once the
+//     opposite band is reached (the thresholds are the hysteresis window)
+// Hysteresis modes can only be used with the low or high band
+typedef enum _ADC0_COMPARE_MODE
+{
+    ADC0_COMPARE_ALWAYS,
+    ADC0_COMPARE_ONCE,
+    ADC0_COMPARE_HYSTERESIS_ALWAYS,
+    ADC0_COMPARE_HYSTERESIS_ONCE
+} ADC0_COMPARE_MODE;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -28,4 +67,41 @@ void setAdc0Ss3Log2AverageCount(uint8_t log2AverageCount);
 void setAdc0Ss3Mux(uint8_t input);
 int16_t readAdc0Ss3();
 
+// Multi-channel sequences with interrupt-driven sample rings
+// Step i of a sequence samples inputs[i]; samples are buffered per step
+bool initAdc0Ss(uint8_t ss, const uint8_t inputs[], uint8_t count);
+void setAdc0SsLog2AverageCount(uint8_t log2AverageCount);
+void startAdc0Ss(uint8_t ss);
+void setAdc0SsCallback(uint8_t ss, ADC0_CALLBACK callback);
+uint16_t getAdc0SsLatest(uint8_t ss, uint8_t step);
+uint8_t getAdc0SsCount(uint8_t ss, uint8_t step);
+bool readAdc0SsSample(uint8_t ss, uint8_t step, uint16_t* sample);
+uint8_t readAdc0SsSamples(uint8_t ss, uint8_t step, uint16_t samples[], uint8_t size);
+uint32_t getAdc0SsOverflowCount(uint8_t ss);
+
+// Timer-triggered acquisition into uDMA ping-pong buffers
+bool startAdc0Acquisition(uint8_t ss, uint32_t sequenceRate, uint32_t fcyc,
+                          uint16_t buffer0[], uint16_t buffer1[], uint16_t size,
+                          ADC0_BLOCK_CALLBACK callback);
+void stopAdc0Acquisition();
+bool isAdc0AcquisitionRunning();
+uint32_t getAdc0AcquisitionBlockCount();
+uint32_t getAdc0AcquisitionOverrunCount();
+
+// Digital comparators
+// A step routed to a comparator is compared in hardware and is not written to the fifo
+bool initAdc0Comparator(uint8_t comparator, uint8_t ss, uint8_t step, uint16_t low, uint16_t high);
+bool enableAdc0ComparatorInterrupt(uint8_t comparator, ADC0_BAND band, ADC0_COMPARE_MODE mode,
+                                   ADC0_COMPARATOR_CALLBACK callback);
+bool enableAdc0ComparatorTrigger(uint8_t comparator, ADC0_BAND band, ADC0_COMPARE_MODE mode);
+void resetAdc0Comparator(uint8_t comparator);
+void disableAdc0Comparator(uint8_t comparator);
+uint32_t getAdc0ComparatorEventCount(uint8_t comparator);
+bool setAdc0SsContinuous(uint8_t ss, bool enable);
+
+void adc0Ss0Isr();
+void adc0Ss1Isr();
+void adc0Ss2Isr();
+void adc0Ss3Isr();
+
 #endif
@@ -8,7 +8,6 @@
 // Target Platform: EK-TM4C123GXL with LCD/Temperature Sensor
 // Target uC:       TM4C123GH6PM
 // System Clock:    40 MHz
-// Stack:           4096 bytes (needed for snprintf)
 
 // Hardware configuration:
 // LM60 Temperature Sensor:
@@ -23,8 +22,6 @@
 // Device includes, defines, and assembler directives
 //-----------------------------------------------------------------------------
 
-#include <stdio.h>
-#include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
@@ -32,11 +29,17 @@
 #include "wait.h"
 #include "uart0.h"
 #include "adc0.h"
+#include "format.h"
+#include "dsp.h"
 #include "tm4c123gh6pm.h"
 
 // PortE masks
 #define AIN3_MASK 1
 
+// Extra fractional bits carried by the filters
+#define FIR_LOG2_LENGTH 4   // 16 tap sliding average, sum is R * 16
+#define IIR_SCALE_BITS  3   // IIR input is R * 8 so 12b samples use most of Q15
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -57,6 +60,16 @@ void initHw()
     GPIO_PORTE_AMSEL_R |= AIN3_MASK;                 // turn on analog operation on pin PE0
 }
 
+// Converts an ADC result scaled by 2^fractionBits to tenths of a degC
+//   T(R) ~= (0.12890625 * (R+0.5)) - 67.84 = (33 * (R+0.5) / 256) - 67.84
+//   10 * T(R) ~= (330 * R - 173505) / 256
+int32_t getTemperatureTenths(int32_t scaledRaw, uint8_t fractionBits)
+{
+    int32_t value = 330 * scaledRaw - (173505 << fractionBits);
+    uint8_t shift = 8 + fractionBits;
+    return (value + (1 << (shift - 1))) >> shift;
+}
+
 //-----------------------------------------------------------------------------
 // Main
 //-----------------------------------------------------------------------------
@@ -64,13 +77,12 @@ void initHw()
 int main(void)
 {
     uint16_t raw;
-    uint16_t x[16];
-    float instantTemp, firTemp, iirTemp = 0;
-    uint8_t index = 0;
-    uint16_t sum = 0; // total fits in 16b since 12b adc output x 16 samples
-    uint8_t i;
-    float alpha = 0.80;
-    char str[80];
+    int16_t firHistory[1 << FIR_LOG2_LENGTH];
+    DSP_MOVING_AVERAGE fir;
+    DSP_BIQUAD iir;
+    int16_t firRaw, iirRaw;
+    char str[160];
+    char* p;
 
     // Initialize hardware
     initHw();
@@ -85,8 +97,10 @@ int main(void)
     setAdc0Ss3Log2AverageCount(2);
 
     // Clear FIR filter taps
-    for (i = 0; i < 16; i++)
-        x[i] = 0;
+    initDspMovingAverage(&fir, firHistory, FIR_LOG2_LENGTH);
+
+    // First order IIR, alpha = 0.80 (see below)
+    initDspBiquad(&iir, Q14(0.20), 0, 0, Q14(-0.80), 0);
 
     // Endless loop
     while(true)
@@ -101,15 +115,12 @@ int main(void)
         //   (~ and 0.5LSb offset in Vin(R) equation are introduced for mid-tread value of the SAR transfer function)
         //   T(Vin) = (Vin - 0.424V) / 0.00625V
         //   T(R) ~= ([3.3V * ((R+0.5) / 4096)] - 0.424V) / 0.00625V
-        //   T(R) ~= (0.12890625 * R) - 67.775546875 (simplified floating point equation to save cycles)
-        instantTemp = (((raw+0.5) / 4096.0 * 3.3) - 0.424) / 0.00625;
+        //   T(R) ~= (0.12890625 * R) - 67.775546875
+        //   This is evaluated in integer tenths of a degree by getTemperatureTenths()
 
         // FIR sliding average filter with circular addressing
-        sum -= x[index];
-        sum += raw;
-        x[index] = raw;
-        index = (index + 1) & 15;
-        firTemp = ((((sum >> 4)+0.5) / 4096.0 * 3.3) - 0.424) / 0.00625;
+        //   The full sum keeps 4 more bits of resolution than the averaged value
+        firRaw = filterDspMovingAverage(&fir, raw);
 
         // IIR filtering of first order, alpha = 0.80
         //   In the z-domain:
@@ -132,22 +143,20 @@ int main(void)
         //     y(n) = alpha * y(n-1) + (1-alpha) * x(n)
         //   Adding an exception for the first sample, yields:
         //     y(n) = alpha * y(n-1) + (1-alpha) * x(n)
-        iirTemp = alpha * iirTemp + (1-alpha)*instantTemp;
+        //   As a biquad with Q14 coefficients: b0 = 1-alpha, a1 = -alpha
+        //   Filtering the ADC value rather than the temperature is equivalent
+        //   since the conversion is linear
+        iirRaw = filterDspBiquad(&iir, raw << IIR_SCALE_BITS);
 
         // display raw ADC value and temperatures
-        snprintf(str, sizeof(str), "Raw ADC:          %4"PRIu16"\n", raw);
-        putsUart0(str);
-        snprintf(str, sizeof(str), "Filtered Raw ADC: %4"PRIu16"\n", sum >> 4);
-        putsUart0(str);
-        snprintf(str, sizeof(str), "Index:              %2"PRIx8"\n", index);
-        putsUart0(str);
-        snprintf(str, sizeof(str), "Unfiltered (C):   %4.1f\n", instantTemp);
-        putsUart0(str);
-        snprintf(str, sizeof(str), "FIR filtered (C): %4.1f\n", firTemp);
-        putsUart0(str);
-        snprintf(str, sizeof(str), "IIR filtered (C): %4.1f\n", iirTemp);
+        p = formatUnsigned(formatString(str, "Raw ADC:          "), raw, 4, ' ');
+        p = formatUnsigned(formatString(p, "\nFiltered Raw ADC: "), firRaw, 4, ' ');
+        p = formatHexLower(formatString(p, "\nIndex:              "), fir.index, 2, ' ');
+        p = formatFixed(formatString(p, "\nUnfiltered (C):   "), getTemperatureTenths(raw, 0), 1, 4);
+        p = formatFixed(formatString(p, "\nFIR filtered (C): "), getTemperatureTenths(getDspMovingAverageSum(&fir), FIR_LOG2_LENGTH), 1, 4);
+        p = formatFixed(formatString(p, "\nIIR filtered (C): "), getTemperatureTenths(iirRaw, IIR_SCALE_BITS), 1, 4);
+        formatString(p, "\n\n");
         putsUart0(str);
-        putsUart0("\n");
 
         waitMicrosecond(1000000);
     }
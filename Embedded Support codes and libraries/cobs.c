@@ -0,0 +1,95 @@
+// COBS Framing Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: -
+// Target uC:       -
+// System Clock:    -
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "cobs.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) remainders for each nibble
+const uint16_t crc16Table[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Encodes size bytes into out (no delimiter is added), returning the encoded length
+uint16_t encodeCobs(const uint8_t in[], uint16_t size, uint8_t out[])
+{
+    uint16_t codeIndex = 0;
+    uint16_t outIndex = 1;
+    uint8_t code = 1;
+    uint16_t i;
+    for (i = 0; i < size; i++)
+    {
+        if (in[i] == 0)
+        {
+            out[codeIndex] = code;
+            codeIndex = outIndex++;
+            code = 1;
+        }
+        else
+        {
+            out[outIndex++] = in[i];
+            code++;
+            if (code == 0xFF)
+            {
+                out[codeIndex] = code;
+                codeIndex = outIndex++;
+                code = 1;
+            }
+        }
+    }
+    out[codeIndex] = code;
+    return outIndex;
+}
+
+// Decodes a frame (without its delimiter) into out, returning the decoded length
+// Returns 0 for a malformed frame
+uint16_t decodeCobs(const uint8_t in[], uint16_t size, uint8_t out[])
+{
+    uint16_t inIndex = 0;
+    uint16_t outIndex = 0;
+    uint8_t code, i;
+    while (inIndex < size)
+    {
+        code = in[inIndex++];
+        if ((code == 0) || (inIndex + code - 1 > size))
+            return 0;
+        for (i = 1; i < code; i++)
+            out[outIndex++] = in[inIndex++];
+        if ((code != 0xFF) && (inIndex < size))
+            out[outIndex++] = 0;
+    }
+    return outIndex;
+}
+
+uint16_t calculateCrc16(const uint8_t data[], uint16_t size)
+{
+    uint16_t crc = 0xFFFF;
+    uint16_t i;
+    for (i = 0; i < size; i++)
+    {
+        crc = (crc << 4) ^ crc16Table[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ crc16Table[(crc >> 12) ^ (data[i] & 0x0F)];
+    }
+    return crc;
+}
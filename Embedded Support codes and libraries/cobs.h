@@ -0,0 +1,37 @@
+// COBS Framing Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: -
+// Target uC:       -
+// System Clock:    -
+
+// Consistent overhead byte stuffing (COBS) removes all zero bytes from a frame
+// so a single 0x00 can delimit frames on a byte stream
+// An encoded frame is at most size + size/254 + 1 bytes
+// Also used by host tools, so there are no hardware dependencies
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef COBS_H_
+#define COBS_H_
+
+#include <stdint.h>
+
+#define COBS_DELIMITER 0x00
+#define COBS_MAX_ENCODED_SIZE(size) ((size) + (size) / 254 + 1)
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+uint16_t encodeCobs(const uint8_t in[], uint16_t size, uint8_t out[]);
+uint16_t decodeCobs(const uint8_t in[], uint16_t size, uint8_t out[]);
+uint16_t calculateCrc16(const uint8_t data[], uint16_t size);
+
+#endif
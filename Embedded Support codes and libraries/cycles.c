@@ -0,0 +1,46 @@
+// Cycle Counter Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// Cortex-M4 DWT cycle counter (32-bit, counts system clocks)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "cycles.h"
+
+// Core debug registers (not included in tm4c123gh6pm.h)
+#define CORE_DEMCR_R         (*((volatile uint32_t *)0xE000EDFC))
+#define DWT_CTRL_R           (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT_R         (*((volatile uint32_t *)0xE0001004))
+
+#define CORE_DEMCR_TRCENA    0x01000000  // enable DWT and ITM
+#define DWT_CTRL_CYCCNTENA   0x00000001  // enable cycle counter
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Start the free-running cycle counter
+// Elapsed cycles are (end - start), which is correct across a single wrap (107 s at 40 MHz)
+void initCycleCounter()
+{
+    CORE_DEMCR_R |= CORE_DEMCR_TRCENA;
+    DWT_CYCCNT_R = 0;
+    DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+}
+
+uint32_t getCycleCount()
+{
+    return DWT_CYCCNT_R;
+}
@@ -0,0 +1,301 @@
+// Fixed-Point DSP Filter Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: -
+// Target uC:       -
+// System Clock:    -
+
+// 64-bit accumulators are used where sums of products can exceed 32 bits;
+// on the Cortex-M4 these compile to single-cycle SMLAL instructions
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp.h"
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Rounds an accumulator with shift fractional bits too many and saturates to Q15
+int16_t roundDspQ15(int64_t acc, uint8_t shift)
+{
+    acc = (acc + ((int64_t)1 << (shift - 1))) >> shift;
+    if (acc > 32767)
+        return 32767;
+    if (acc < -32768)
+        return -32768;
+    return acc;
+}
+
+int32_t roundDspQ31(int64_t acc, uint8_t shift)
+{
+    acc = (acc + ((int64_t)1 << (shift - 1))) >> shift;
+    if (acc > 2147483647)
+        return 2147483647;
+    if (acc < -2147483647 - 1)
+        return -2147483647 - 1;
+    return acc;
+}
+
+// Moving average
+// history must hold 2^log2Length samples; the output is the rounded mean
+void initDspMovingAverage(DSP_MOVING_AVERAGE* filter, int16_t history[], uint8_t log2Length)
+{
+    uint16_t i;
+    filter->history = history;
+    filter->log2Length = log2Length;
+    filter->mask = (1 << log2Length) - 1;
+    filter->index = 0;
+    filter->sum = 0;
+    for (i = 0; i <= filter->mask; i++)
+        history[i] = 0;
+}
+
+int16_t filterDspMovingAverage(DSP_MOVING_AVERAGE* filter, int16_t x)
+{
+    filter->sum += x - filter->history[filter->index];
+    filter->history[filter->index] = x;
+    filter->index = (filter->index + 1) & filter->mask;
+    if (filter->log2Length == 0)
+        return filter->sum;
+    return (filter->sum + (1 << (filter->log2Length - 1))) >> filter->log2Length;
+}
+
+void filterDspMovingAverageBlock(DSP_MOVING_AVERAGE* filter, const int16_t in[], int16_t out[], uint16_t size)
+{
+    uint16_t i;
+    for (i = 0; i < size; i++)
+        out[i] = filterDspMovingAverage(filter, in[i]);
+}
+
+// Unrounded sum of the window (the mean with log2Length extra bits of resolution)
+int32_t getDspMovingAverageSum(DSP_MOVING_AVERAGE* filter)
+{
+    return filter->sum;
+}
+
+// FIR
+// y(n) = sum(k = 0..N-1) {bk * x(n-k)}, with history holding N samples
+void initDspFir(DSP_FIR* filter, const int16_t coefficients[], int16_t history[], uint16_t length)
+{
+    uint16_t i;
+    filter->coefficients = coefficients;
+    filter->history = history;
+    filter->length = length;
+    filter->index = 0;
+    for (i = 0; i < length; i++)
+        history[i] = 0;
+}
+
+int16_t filterDspFir(DSP_FIR* filter, int16_t x)
+{
+    const int16_t* b = filter->coefficients;
+    int16_t* h = filter->history;
+    int64_t acc = 0;
+    uint16_t k = 0;
+    uint16_t i = filter->index;
+    h[i] = x;
+    // newest to the end of the buffer, then wrap to the oldest
+    while (true)
+    {
+        acc += (int32_t)b[k++] * h[i];
+        if (k == filter->length)
+            break;
+        i = (i == 0) ? filter->length - 1 : i - 1;
+    }
+    filter->index = (filter->index + 1 == filter->length) ? 0 : filter->index + 1;
+    return roundDspQ15(acc, 15);
+}
+
+void filterDspFirBlock(DSP_FIR* filter, const int16_t in[], int16_t out[], uint16_t size)
+{
+    uint16_t i;
+    for (i = 0; i < size; i++)
+        out[i] = filterDspFir(filter, in[i]);
+}
+
+// Biquad (Q15 data, Q14 coefficients)
+// A first-order IIR y(n) = alpha * y(n-1) + (1-alpha) * x(n) is
+// b0 = Q14(1-alpha), a1 = Q14(-alpha), and b1 = b2 = a2 = 0
+void initDspBiquad(DSP_BIQUAD* filter, int16_t b0, int16_t b1, int16_t b2, int16_t a1, int16_t a2)
+{
+    filter->b0 = b0;
+    filter->b1 = b1;
+    filter->b2 = b2;
+    filter->a1 = a1;
+    filter->a2 = a2;
+    filter->x1 = filter->x2 = filter->y1 = filter->y2 = 0;
+}
+
+int16_t filterDspBiquad(DSP_BIQUAD* filter, int16_t x)
+{
+    int64_t acc;
+    int16_t y;
+    acc = (int32_t)filter->b0 * x;
+    acc += (int32_t)filter->b1 * filter->x1;
+    acc += (int32_t)filter->b2 * filter->x2;
+    acc -= (int32_t)filter->a1 * filter->y1;
+    acc -= (int32_t)filter->a2 * filter->y2;
+    y = roundDspQ15(acc, 14);
+    filter->x2 = filter->x1;
+    filter->x1 = x;
+    filter->y2 = filter->y1;
+    filter->y1 = y;
+    return y;
+}
+
+void filterDspBiquadBlock(DSP_BIQUAD* filter, const int16_t in[], int16_t out[], uint16_t size)
+{
+    uint16_t i;
+    for (i = 0; i < size; i++)
+        out[i] = filterDspBiquad(filter, in[i]);
+}
+
+// Runs a sample through count sections in series (higher order filters)
+int16_t filterDspBiquadCascade(DSP_BIQUAD filter[], uint8_t count, int16_t x)
+{
+    uint8_t i;
+    for (i = 0; i < count; i++)
+        x = filterDspBiquad(&filter[i], x);
+    return x;
+}
+
+// Biquad (Q31 data, Q30 coefficients)
+// Products are pre-shifted by 2 bits so the sum of five Q61 products fits in 64 bits
+void initDspBiquadQ31(DSP_BIQUAD_Q31* filter, int32_t b0, int32_t b1, int32_t b2, int32_t a1, int32_t a2)
+{
+    filter->b0 = b0;
+    filter->b1 = b1;
+    filter->b2 = b2;
+    filter->a1 = a1;
+    filter->a2 = a2;
+    filter->x1 = filter->x2 = filter->y1 = filter->y2 = 0;
+}
+
+int32_t filterDspBiquadQ31(DSP_BIQUAD_Q31* filter, int32_t x)
+{
+    int64_t acc;
+    int32_t y;
+    acc = ((int64_t)filter->b0 * x) >> 2;
+    acc += ((int64_t)filter->b1 * filter->x1) >> 2;
+    acc += ((int64_t)filter->b2 * filter->x2) >> 2;
+    acc -= ((int64_t)filter->a1 * filter->y1) >> 2;
+    acc -= ((int64_t)filter->a2 * filter->y2) >> 2;
+    y = roundDspQ31(acc, 28);
+    filter->x2 = filter->x1;
+    filter->x1 = x;
+    filter->y2 = filter->y1;
+    filter->y1 = y;
+    return y;
+}
+
+void filterDspBiquadQ31Block(DSP_BIQUAD_Q31* filter, const int32_t in[], int32_t out[], uint16_t size)
+{
+    uint16_t i;
+    for (i = 0; i < size; i++)
+        out[i] = filterDspBiquadQ31(filter, in[i]);
+}
+
+// Median
+// The window is kept sorted, so each sample costs one removal and one insertion
+// Returns false if length is even or too long
+bool initDspMedian(DSP_MEDIAN* filter, uint8_t length, int16_t initial)
+{
+    uint8_t i;
+    if ((length & 1) == 0 || length > DSP_MAX_MEDIAN)
+        return false;
+    filter->length = length;
+    filter->index = 0;
+    for (i = 0; i < length; i++)
+        filter->history[i] = filter->sorted[i] = initial;
+    return true;
+}
+
+int16_t filterDspMedian(DSP_MEDIAN* filter, int16_t x)
+{
+    int16_t* s = filter->sorted;
+    int16_t old = filter->history[filter->index];
+    uint8_t i = 0;
+    filter->history[filter->index] = x;
+    if (++filter->index == filter->length)
+        filter->index = 0;
+    // remove the oldest sample
+    while (s[i] != old)
+        i++;
+    for (; i < filter->length - 1; i++)
+        s[i] = s[i + 1];
+    // insert the new sample
+    while (i > 0 && s[i - 1] > x)
+    {
+        s[i] = s[i - 1];
+        i--;
+    }
+    s[i] = x;
+    return s[filter->length >> 1];
+}
+
+void filterDspMedianBlock(DSP_MEDIAN* filter, const int16_t in[], int16_t out[], uint16_t size)
+{
+    uint16_t i;
+    for (i = 0; i < size; i++)
+        out[i] = filterDspMedian(filter, in[i]);
+}
+
+// CIC decimator
+// Returns false if the order is out of range or the gain does not fit in 32 bits
+bool initDspCic(DSP_CIC* filter, uint8_t order, uint8_t log2Decimation)
+{
+    uint8_t i;
+    if (order == 0 || order > DSP_MAX_CIC_ORDER || order * log2Decimation > 16)
+        return false;
+    filter->order = order;
+    filter->log2Decimation = log2Decimation;
+    filter->phase = 0;
+    for (i = 0; i < DSP_MAX_CIC_ORDER; i++)
+        filter->integrator[i] = filter->comb[i] = 0;
+    return true;
+}
+
+// Adds an input sample and returns true with an output sample every 2^log2Decimation inputs
+bool filterDspCic(DSP_CIC* filter, int16_t x, int16_t* y)
+{
+    uint32_t v = (uint32_t)(int32_t)x;
+    uint32_t t;
+    uint8_t i;
+    uint8_t shift = filter->order * filter->log2Decimation;
+    for (i = 0; i < filter->order; i++)
+    {
+        filter->integrator[i] += v;
+        v = filter->integrator[i];
+    }
+    if (++filter->phase < (1 << filter->log2Decimation))
+        return false;
+    filter->phase = 0;
+    for (i = 0; i < filter->order; i++)
+    {
+        t = v;
+        v -= filter->comb[i];
+        filter->comb[i] = t;
+    }
+    *y = (shift == 0) ? (int16_t)(int32_t)v : roundDspQ15((int32_t)v, shift);
+    return true;
+}
+
+// Returns the number of output samples written
+uint16_t filterDspCicBlock(DSP_CIC* filter, const int16_t in[], int16_t out[], uint16_t size)
+{
+    uint16_t i;
+    uint16_t count = 0;
+    for (i = 0; i < size; i++)
+        if (filterDspCic(filter, in[i], &out[count]))
+            count++;
+    return count;
+}
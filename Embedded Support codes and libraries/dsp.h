@@ -0,0 +1,127 @@
+// Fixed-Point DSP Filter Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: -
+// Target uC:       -
+// System Clock:    -
+
+// Integer filters for ADC data, with a per-sample and a block function for each
+// Formats:
+//   Q15 values are int16_t with 15 fractional bits (-1 to 1-2^-15)
+//   Q31 values are int32_t with 31 fractional bits
+//   Raw ADC samples (0-4095) can be used directly as Q15 values; scaling them up
+//   (up to 8x) keeps more fractional resolution in the IIR filters
+// Results are rounded and saturated; each filter keeps its own state, so one
+// instance is needed per channel
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef DSP_H_
+#define DSP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DSP_MAX_MEDIAN 15
+#define DSP_MAX_CIC_ORDER 4
+
+// Converts a constant in the range -1 to 1 to Q15 or Q31 (for initializers)
+#define Q15(x) ((int16_t)((x) >= 0.999969482421875 ? 32767 : (x) * 32768.0 + ((x) >= 0 ? 0.5 : -0.5)))
+#define Q31(x) ((int32_t)((x) >= 0.9999999995343387 ? 2147483647 : (x) * 2147483648.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+// Converts a biquad coefficient in the range -2 to 2 to the Q14 or Q30 coefficient formats
+#define Q14(x) ((int16_t)((x) >= 1.99993896484375 ? 32767 : (x) * 16384.0 + ((x) >= 0 ? 0.5 : -0.5)))
+#define Q30(x) ((int32_t)((x) >= 1.9999999990686774 ? 2147483647 : (x) * 1073741824.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+// Sliding sum of the last 2^log2Length samples
+typedef struct _DSP_MOVING_AVERAGE
+{
+    int16_t* history;
+    uint16_t mask;
+    uint16_t index;
+    uint8_t log2Length;
+    int32_t sum;
+} DSP_MOVING_AVERAGE;
+
+// Direct form FIR with Q15 coefficients
+typedef struct _DSP_FIR
+{
+    const int16_t* coefficients;   // b0..bN-1
+    int16_t* history;              // N samples, newest at index
+    uint16_t length;
+    uint16_t index;
+} DSP_FIR;
+
+// Direct form I biquad section with coefficients in Q14 (Q15 data) or Q30 (Q31 data)
+// y(n) = b0 x(n) + b1 x(n-1) + b2 x(n-2) - a1 y(n-1) - a2 y(n-2)
+typedef struct _DSP_BIQUAD
+{
+    int16_t b0, b1, b2, a1, a2;
+    int16_t x1, x2, y1, y2;
+} DSP_BIQUAD;
+
+typedef struct _DSP_BIQUAD_Q31
+{
+    int32_t b0, b1, b2, a1, a2;
+    int32_t x1, x2, y1, y2;
+} DSP_BIQUAD_Q31;
+
+// Running median of an odd window of up to DSP_MAX_MEDIAN samples
+typedef struct _DSP_MEDIAN
+{
+    int16_t history[DSP_MAX_MEDIAN];   // arrival order
+    int16_t sorted[DSP_MAX_MEDIAN];
+    uint8_t length;
+    uint8_t index;
+} DSP_MEDIAN;
+
+// Decimating CIC (cascaded integrator-comb) with a differential delay of 1
+// The gain of 2^(order * log2Decimation) is removed, so the output has the input scale
+// Integrators wrap; this is exact as long as the input bits plus
+// order * log2Decimation do not exceed 32
+typedef struct _DSP_CIC
+{
+    uint32_t integrator[DSP_MAX_CIC_ORDER];   // unsigned so wrapping is defined
+    uint32_t comb[DSP_MAX_CIC_ORDER];
+    uint8_t order;
+    uint8_t log2Decimation;
+    uint16_t phase;
+} DSP_CIC;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initDspMovingAverage(DSP_MOVING_AVERAGE* filter, int16_t history[], uint8_t log2Length);
+int16_t filterDspMovingAverage(DSP_MOVING_AVERAGE* filter, int16_t x);
+void filterDspMovingAverageBlock(DSP_MOVING_AVERAGE* filter, const int16_t in[], int16_t out[], uint16_t size);
+int32_t getDspMovingAverageSum(DSP_MOVING_AVERAGE* filter);
+
+void initDspFir(DSP_FIR* filter, const int16_t coefficients[], int16_t history[], uint16_t length);
+int16_t filterDspFir(DSP_FIR* filter, int16_t x);
+void filterDspFirBlock(DSP_FIR* filter, const int16_t in[], int16_t out[], uint16_t size);
+
+void initDspBiquad(DSP_BIQUAD* filter, int16_t b0, int16_t b1, int16_t b2, int16_t a1, int16_t a2);
+int16_t filterDspBiquad(DSP_BIQUAD* filter, int16_t x);
+void filterDspBiquadBlock(DSP_BIQUAD* filter, const int16_t in[], int16_t out[], uint16_t size);
+int16_t filterDspBiquadCascade(DSP_BIQUAD filter[], uint8_t count, int16_t x);
+
+void initDspBiquadQ31(DSP_BIQUAD_Q31* filter, int32_t b0, int32_t b1, int32_t b2, int32_t a1, int32_t a2);
+int32_t filterDspBiquadQ31(DSP_BIQUAD_Q31* filter, int32_t x);
+void filterDspBiquadQ31Block(DSP_BIQUAD_Q31* filter, const int32_t in[], int32_t out[], uint16_t size);
+
+bool initDspMedian(DSP_MEDIAN* filter, uint8_t length, int16_t initial);
+int16_t filterDspMedian(DSP_MEDIAN* filter, int16_t x);
+void filterDspMedianBlock(DSP_MEDIAN* filter, const int16_t in[], int16_t out[], uint16_t size);
+
+bool initDspCic(DSP_CIC* filter, uint8_t order, uint8_t log2Decimation);
+bool filterDspCic(DSP_CIC* filter, int16_t x, int16_t* y);
+uint16_t filterDspCicBlock(DSP_CIC* filter, const int16_t in[], int16_t out[], uint16_t size);
+
+#endif
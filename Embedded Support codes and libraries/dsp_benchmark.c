@@ -0,0 +1,187 @@
+// Fixed-Point DSP Benchmark Example
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// UART Interface:
+//   U0TX (PA1) and U0RX (PA0) are connected to the 2nd controller
+//   The USB on the 2nd controller enumerates to an ICDI interface and a virtual COM port
+//   Configured to 115,200 baud, 8N1
+
+// Runs each filter in the DSP library over a noisy test signal with impulses
+// and reports the cycles per sample of the block functions; a float version
+// of the analog example IIR is timed for comparison
+// The outputs are checked against double precision references by dsp_host_test.c
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "clock.h"
+#include "uart0.h"
+#include "cycles.h"
+#include "format.h"
+#include "dsp.h"
+#include "tm4c123gh6pm.h"
+
+#define PI 3.14159265358979323846
+#define SIZE 512
+#define FIR_LENGTH 9
+#define MEDIAN_LENGTH 7
+#define CIC_ORDER 3
+#define CIC_LOG2_DECIMATION 3
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+int16_t in[SIZE];
+int16_t out[SIZE];
+int32_t in32[SIZE];
+int32_t out32[SIZE];
+float inFloat[SIZE];
+float outFloat[SIZE];
+
+// Hann window lowpass, sums to 1
+const double firTaps[FIR_LENGTH] = {0.0, 0.0366, 0.1250, 0.2134, 0.25, 0.2134, 0.1250, 0.0366, 0.0};
+int16_t firCoefficients[FIR_LENGTH];
+
+// 2nd order Butterworth lowpass at fs/20
+const double b0 = 0.020083, b1 = 0.040167, b2 = 0.020083, a1 = -1.561018, a2 = 0.641352;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Initialize Hardware
+void initHw()
+{
+    // Initialize system clock to 40 MHz
+    initSystemClockTo40Mhz();
+}
+
+// Sine at fs/64 plus pseudo-random noise and an impulse every 61 samples
+void makeTestSignal()
+{
+    uint32_t seed = 1;
+    uint16_t i;
+    for (i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        in[i] = 12000 * sin(i * 2 * PI / 64) + (int16_t)(seed >> 16) / 16;
+        if (i % 61 == 0)
+            in[i] = 30000;
+        in32[i] = (int32_t)in[i] << 16;
+        inFloat[i] = in[i];
+    }
+}
+
+void printResult(const char name[], uint32_t cycles)
+{
+    char str[80];
+    char* p;
+    p = formatString(str, name);
+    p = formatUnsigned(formatString(p, " cycles/sample: "), cycles / SIZE, 5, ' ');
+    formatString(p, "\n");
+    putsUart0(str);
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main(void)
+{
+    DSP_MOVING_AVERAGE movingAverage;
+    int16_t movingAverageHistory[16];
+    DSP_FIR fir;
+    int16_t firHistory[FIR_LENGTH];
+    DSP_BIQUAD biquad;
+    DSP_BIQUAD_Q31 biquadQ31;
+    DSP_MEDIAN median;
+    DSP_CIC cic;
+    float yFloat = 0;
+    uint32_t start, cycles;
+    uint16_t i;
+
+    // Initialize hardware
+    initHw();
+    initUart0();
+    initCycleCounter();
+
+    // Setup UART0 baud rate
+    setUart0BaudRate(115200, 40e6);
+
+    putsUart0("DSP Benchmark\n");
+    makeTestSignal();
+
+    // Moving average (16 samples)
+    initDspMovingAverage(&movingAverage, movingAverageHistory, 4);
+    start = getCycleCount();
+    filterDspMovingAverageBlock(&movingAverage, in, out, SIZE);
+    cycles = getCycleCount() - start;
+    printResult("Moving average ", cycles);
+
+    // FIR
+    for (i = 0; i < FIR_LENGTH; i++)
+        firCoefficients[i] = Q15(firTaps[i]);
+    initDspFir(&fir, firCoefficients, firHistory, FIR_LENGTH);
+    start = getCycleCount();
+    filterDspFirBlock(&fir, in, out, SIZE);
+    cycles = getCycleCount() - start;
+    printResult("FIR (9 taps)   ", cycles);
+
+    // Biquads
+    initDspBiquad(&biquad, Q14(b0), Q14(b1), Q14(b2), Q14(a1), Q14(a2));
+    start = getCycleCount();
+    filterDspBiquadBlock(&biquad, in, out, SIZE);
+    cycles = getCycleCount() - start;
+    printResult("Biquad Q15     ", cycles);
+
+    initDspBiquadQ31(&biquadQ31, Q30(b0), Q30(b1), Q30(b2), Q30(a1), Q30(a2));
+    start = getCycleCount();
+    filterDspBiquadQ31Block(&biquadQ31, in32, out32, SIZE);
+    cycles = getCycleCount() - start;
+    printResult("Biquad Q31     ", cycles);
+
+    // Median
+    initDspMedian(&median, MEDIAN_LENGTH, 0);
+    start = getCycleCount();
+    filterDspMedianBlock(&median, in, out, SIZE);
+    cycles = getCycleCount() - start;
+    printResult("Median (7)     ", cycles);
+
+    // CIC (order 3, decimate by 8)
+    initDspCic(&cic, CIC_ORDER, CIC_LOG2_DECIMATION);
+    start = getCycleCount();
+    filterDspCicBlock(&cic, in, out, SIZE);
+    cycles = getCycleCount() - start;
+    printResult("CIC (3, 8)     ", cycles);
+
+    // Float IIR from the original analog example, for comparison
+    start = getCycleCount();
+    for (i = 0; i < SIZE; i++)
+    {
+        yFloat = 0.8f * yFloat + 0.2f * inFloat[i];
+        outFloat[i] = yFloat;
+    }
+    cycles = getCycleCount() - start;
+    printResult("1st order float", cycles);
+    initDspBiquad(&biquad, Q14(0.2), 0, 0, Q14(-0.8), 0);
+    start = getCycleCount();
+    filterDspBiquadBlock(&biquad, in, out, SIZE);
+    cycles = getCycleCount() - start;
+    printResult("1st order Q15  ", cycles);
+
+    while (true);
+}
@@ -0,0 +1,281 @@
+// Fixed-Point DSP Host Test
+// Jason Losh
+
+// Runs each filter in the DSP library over a noisy test signal with impulses
+// and checks:
+//   the output against a double precision reference, within a limit in LSb
+//   that the block function matches the sample-by-sample function
+//   that invalid configurations are rejected
+// Exits with EXIT_SUCCESS if all checks pass
+// Cycle counts are measured on the target with dsp_benchmark.c
+
+// Build: gcc -std=c99 -o dsp_test dsp_host_test.c dsp.c -lm
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Linux PC
+// Target uC:       -
+// System Clock:    -
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>          // EXIT_ codes
+#include <stdio.h>           // printf
+#include <stdint.h>          // C99 integer types
+#include <stdbool.h>         // bool
+#include <string.h>          // memcmp
+#include <math.h>            // sin, fabs
+#include "dsp.h"
+
+#define PI 3.14159265358979323846
+#define SIZE 2048
+#define FIR_LENGTH 9
+#define MEDIAN_LENGTH 7
+#define CIC_ORDER 3
+#define CIC_LOG2_DECIMATION 3
+#define CIC_DECIMATION (1 << CIC_LOG2_DECIMATION)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+int16_t in[SIZE];
+int16_t out[SIZE];
+int16_t outBlock[SIZE];
+int32_t in32[SIZE];
+int32_t out32[SIZE];
+int32_t out32Block[SIZE];
+double reference[SIZE];
+
+// Hann window lowpass, sums to 1
+const double firTaps[FIR_LENGTH] = {0.0, 0.0366, 0.1250, 0.2134, 0.25, 0.2134, 0.1250, 0.0366, 0.0};
+int16_t firCoefficients[FIR_LENGTH];
+
+// 2nd order Butterworth lowpass at fs/20
+const double b0 = 0.020083, b1 = 0.040167, b2 = 0.020083, a1 = -1.561018, a2 = 0.641352;
+
+uint16_t failures = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Sine at fs/64 plus pseudo-random noise and an impulse every 61 samples
+// scale halves the signal to leave headroom for the overshoot of the biquads
+void makeTestSignal(uint8_t scale)
+{
+    uint32_t seed = 1;
+    uint16_t i;
+    for (i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        in[i] = 12000 * sin(i * 2 * PI / 64) + (int16_t)(seed >> 16) / 16;
+        if (i % 61 == 0)
+            in[i] = 30000;
+        in[i] /= scale;
+        in32[i] = (int32_t)in[i] << 16;
+    }
+}
+
+// Returns the largest difference between the output and the reference, in LSb of scale
+double getMaxError(const int16_t output[], const int32_t output32[], uint16_t size, double scale)
+{
+    double error, maxError = 0;
+    uint16_t i;
+    for (i = 0; i < size; i++)
+    {
+        error = fabs((output ? output[i] : output32[i]) - reference[i]) / scale;
+        if (error > maxError)
+            maxError = error;
+    }
+    return maxError;
+}
+
+void check(const char name[], bool pass, double maxError, double limit)
+{
+    pass = pass && (maxError <= limit);
+    printf("%-22s max error %8.4f LSb (limit %6.4f)  %s\n", name, maxError, limit, pass ? "pass" : "FAIL");
+    if (!pass)
+        failures++;
+}
+
+void testMovingAverage()
+{
+    DSP_MOVING_AVERAGE filter;
+    int16_t history[16];
+    double sum;
+    uint16_t i, j;
+    makeTestSignal(1);
+    for (i = 0; i < SIZE; i++)
+    {
+        sum = 0;
+        for (j = 0; j < 16 && j <= i; j++)
+            sum += in[i - j];
+        reference[i] = sum / 16;
+    }
+    initDspMovingAverage(&filter, history, 4);
+    for (i = 0; i < SIZE; i++)
+        out[i] = filterDspMovingAverage(&filter, in[i]);
+    initDspMovingAverage(&filter, history, 4);
+    filterDspMovingAverageBlock(&filter, in, outBlock, SIZE);
+    // rounding only
+    check("Moving average (16)", memcmp(out, outBlock, sizeof(out)) == 0,
+          getMaxError(out, 0, SIZE, 1), 0.5);
+}
+
+void testFir()
+{
+    DSP_FIR filter;
+    int16_t history[FIR_LENGTH];
+    double sum;
+    uint16_t i, j;
+    makeTestSignal(1);
+    for (i = 0; i < FIR_LENGTH; i++)
+        firCoefficients[i] = Q15(firTaps[i]);
+    for (i = 0; i < SIZE; i++)
+    {
+        sum = 0;
+        for (j = 0; j < FIR_LENGTH && j <= i; j++)
+            sum += firCoefficients[j] / 32768.0 * in[i - j];
+        reference[i] = sum;
+    }
+    initDspFir(&filter, firCoefficients, history, FIR_LENGTH);
+    for (i = 0; i < SIZE; i++)
+        out[i] = filterDspFir(&filter, in[i]);
+    initDspFir(&filter, firCoefficients, history, FIR_LENGTH);
+    filterDspFirBlock(&filter, in, outBlock, SIZE);
+    // rounding only, since the reference uses the Q15 coefficients
+    check("FIR (9 taps)", memcmp(out, outBlock, sizeof(out)) == 0,
+          getMaxError(out, 0, SIZE, 1), 0.5);
+}
+
+// Double precision direct form I biquad, with the input and output scaled by scale
+void makeBiquadReference(double scale)
+{
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0, y;
+    uint16_t i;
+    for (i = 0; i < SIZE; i++)
+    {
+        y = b0 * in[i] + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = in[i];
+        y2 = y1;
+        y1 = y;
+        reference[i] = y * scale;
+    }
+}
+
+void testBiquad()
+{
+    DSP_BIQUAD filter;
+    uint16_t i;
+    makeTestSignal(2);
+    makeBiquadReference(1);
+    initDspBiquad(&filter, Q14(b0), Q14(b1), Q14(b2), Q14(a1), Q14(a2));
+    for (i = 0; i < SIZE; i++)
+        out[i] = filterDspBiquad(&filter, in[i]);
+    initDspBiquad(&filter, Q14(b0), Q14(b1), Q14(b2), Q14(a1), Q14(a2));
+    filterDspBiquadBlock(&filter, in, outBlock, SIZE);
+    // Q14 coefficients move the poles near z = 1, so the error grows with the
+    // low frequency gain (about 4 LSb measured)
+    check("Biquad Q15", memcmp(out, outBlock, sizeof(out)) == 0,
+          getMaxError(out, 0, SIZE, 1), 6.0);
+}
+
+void testBiquadQ31()
+{
+    DSP_BIQUAD_Q31 filter;
+    uint16_t i;
+    makeTestSignal(2);
+    makeBiquadReference(65536);
+    initDspBiquadQ31(&filter, Q30(b0), Q30(b1), Q30(b2), Q30(a1), Q30(a2));
+    for (i = 0; i < SIZE; i++)
+        out32[i] = filterDspBiquadQ31(&filter, in32[i]);
+    initDspBiquadQ31(&filter, Q30(b0), Q30(b1), Q30(b2), Q30(a1), Q30(a2));
+    filterDspBiquadQ31Block(&filter, in32, out32Block, SIZE);
+    // error in LSb of the Q15 scale
+    check("Biquad Q31", memcmp(out32, out32Block, sizeof(out32)) == 0,
+          getMaxError(0, out32, SIZE, 65536), 0.01);
+}
+
+void testMedian()
+{
+    DSP_MEDIAN filter;
+    int16_t window[MEDIAN_LENGTH], t;
+    uint16_t i, j, k;
+    bool pass;
+    makeTestSignal(1);
+    for (i = 0; i < SIZE; i++)
+    {
+        for (j = 0; j < MEDIAN_LENGTH; j++)
+            window[j] = (j <= i) ? in[i - j] : 0;
+        for (j = 1; j < MEDIAN_LENGTH; j++)
+            for (k = j; k > 0 && window[k - 1] > window[k]; k--)
+            {
+                t = window[k];
+                window[k] = window[k - 1];
+                window[k - 1] = t;
+            }
+        reference[i] = window[MEDIAN_LENGTH / 2];
+    }
+    pass = initDspMedian(&filter, MEDIAN_LENGTH, 0);
+    for (i = 0; i < SIZE; i++)
+        out[i] = filterDspMedian(&filter, in[i]);
+    initDspMedian(&filter, MEDIAN_LENGTH, 0);
+    filterDspMedianBlock(&filter, in, outBlock, SIZE);
+    pass = pass && !initDspMedian(&filter, 6, 0) && !initDspMedian(&filter, DSP_MAX_MEDIAN + 2, 0);
+    // exact
+    check("Median (7)", pass && memcmp(out, outBlock, sizeof(out)) == 0,
+          getMaxError(out, 0, SIZE, 1), 0);
+}
+
+void testCic()
+{
+    DSP_CIC filter;
+    double sum[SIZE];
+    uint16_t i, j, k, count = 0, countBlock;
+    bool pass;
+    makeTestSignal(1);
+    // order 3 cascade of moving sums of 8 samples, sampled at the end of each block
+    for (i = 0; i < SIZE; i++)
+        sum[i] = in[i];
+    for (k = 0; k < CIC_ORDER; k++)
+        for (i = SIZE; i-- > 0;)
+            for (j = 1; j < CIC_DECIMATION && j <= i; j++)
+                sum[i] += sum[i - j];
+    for (i = 0; i < SIZE / CIC_DECIMATION; i++)
+        reference[i] = sum[i * CIC_DECIMATION + CIC_DECIMATION - 1]
+                       / (1 << (CIC_ORDER * CIC_LOG2_DECIMATION));
+    pass = initDspCic(&filter, CIC_ORDER, CIC_LOG2_DECIMATION);
+    for (i = 0; i < SIZE; i++)
+        if (filterDspCic(&filter, in[i], &out[count]))
+            count++;
+    initDspCic(&filter, CIC_ORDER, CIC_LOG2_DECIMATION);
+    countBlock = filterDspCicBlock(&filter, in, outBlock, SIZE);
+    pass = pass && (count == SIZE / CIC_DECIMATION) && (countBlock == count);
+    pass = pass && !initDspCic(&filter, 0, 3) && !initDspCic(&filter, DSP_MAX_CIC_ORDER + 1, 1)
+           && !initDspCic(&filter, 4, 5);
+    // rounding only
+    check("CIC (3, 8)", pass && memcmp(out, outBlock, count * sizeof(int16_t)) == 0,
+          getMaxError(out, 0, count, 1), 0.5);
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main(void)
+{
+    testMovingAverage();
+    testFir();
+    testBiquad();
+    testBiquadQ31();
+    testMedian();
+    testCic();
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
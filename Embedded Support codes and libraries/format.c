@@ -0,0 +1,193 @@
+// Formatted Output Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: -
+// Target uC:       -
+// System Clock:    -
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "format.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Two ASCII digits for each value 0-99, so each divide by 100 yields two characters
+const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+const char hexDigits[17] = "0123456789ABCDEF";
+const char hexDigitsLower[17] = "0123456789abcdef";
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Returns the number of decimal digits in value (at least 1)
+uint8_t countDigits(uint32_t value)
+{
+    uint8_t count = 1;
+    while (value >= 10000)
+    {
+        value /= 10000;
+        count += 4;
+    }
+    if (value >= 10)   count++;
+    if (value >= 100)  count++;
+    if (value >= 1000) count++;
+    return count;
+}
+
+// Writes exactly count digits of value ending before end
+void writeDigits(char* end, uint32_t value)
+{
+    const char* pair;
+    while (value >= 100)
+    {
+        pair = &digitPairs[(value % 100) * 2];
+        value /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    if (value >= 10)
+    {
+        pair = &digitPairs[value * 2];
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    else
+        *--end = '0' + value;
+}
+
+// Writes an optional sign and magnitude right justified in width
+// Zero padding goes between the sign and digits, other padding before the sign
+char* formatMagnitude(char* str, uint32_t magnitude, bool negative, uint8_t width, char pad)
+{
+    uint8_t digits = countDigits(magnitude);
+    uint8_t length = digits + negative;
+    if (pad != '0')
+        while (width > length)
+        {
+            *str++ = pad;
+            width--;
+        }
+    if (negative)
+        *str++ = '-';
+    while (width > length)
+    {
+        *str++ = '0';
+        width--;
+    }
+    str += digits;
+    writeDigits(str, magnitude);
+    *str = '\0';
+    return str;
+}
+
+// Equivalent to "%*u" (pad ' ') or "%0*u" (pad '0')
+char* formatUnsigned(char* str, uint32_t value, uint8_t width, char pad)
+{
+    return formatMagnitude(str, value, false, width, pad);
+}
+
+// Equivalent to "%*d" (pad ' ') or "%0*d" (pad '0')
+char* formatSigned(char* str, int32_t value, uint8_t width, char pad)
+{
+    if (value < 0)
+        return formatMagnitude(str, -(uint32_t)value, true, width, pad);
+    return formatMagnitude(str, value, false, width, pad);
+}
+
+// Writes value in hex using the digit set of the caller
+char* formatHexDigits(char* str, uint32_t value, uint8_t width, char pad, const char digitSet[])
+{
+    uint8_t digits = 1;
+    uint8_t i;
+    while ((digits < 8) && (value >> (digits * 4)))
+        digits++;
+    while (width > digits)
+    {
+        *str++ = pad;
+        width--;
+    }
+    for (i = digits; i > 0; i--)
+        *str++ = digitSet[(value >> ((i - 1) * 4)) & 15];
+    *str = '\0';
+    return str;
+}
+
+// Equivalent to "%*X" (pad ' ') or "%0*X" (pad '0')
+char* formatHex(char* str, uint32_t value, uint8_t width, char pad)
+{
+    return formatHexDigits(str, value, width, pad, hexDigits);
+}
+
+// Equivalent to "%*x" (pad ' ') or "%0*x" (pad '0')
+char* formatHexLower(char* str, uint32_t value, uint8_t width, char pad)
+{
+    return formatHexDigits(str, value, width, pad, hexDigitsLower);
+}
+
+// Fixed-point value in units of 10^-decimals, space padded to width
+// Equivalent to "%*.*f" for value / 10^decimals, e.g. (253, 1, 5) gives " 25.3"
+char* formatFixed(char* str, int32_t value, uint8_t decimals, uint8_t width)
+{
+    uint32_t magnitude = (value < 0) ? -(uint32_t)value : (uint32_t)value;
+    uint32_t scale = 1;
+    uint32_t fraction;
+    uint8_t i;
+    for (i = 0; i < decimals; i++)
+        scale *= 10;
+    fraction = magnitude % scale;
+    magnitude /= scale;
+    // integer part with sign, leaving room in the width for the point and fraction
+    if (decimals > 0)
+        width = (width > decimals + 1) ? width - decimals - 1 : 0;
+    str = formatMagnitude(str, magnitude, value < 0, width, ' ');
+    if (decimals > 0)
+    {
+        *str++ = '.';
+        str += decimals;
+        for (i = 0; i < decimals; i++)
+        {
+            *(str - 1 - i) = '0' + fraction % 10;
+            fraction /= 10;
+        }
+        *str = '\0';
+    }
+    return str;
+}
+
+// Copies a string
+char* formatString(char* str, const char src[])
+{
+    while (*src != '\0')
+        *str++ = *src++;
+    *str = '\0';
+    return str;
+}
+
+char* formatChar(char* str, char c)
+{
+    *str++ = c;
+    *str = '\0';
+    return str;
+}
@@ -0,0 +1,41 @@
+// Formatted Output Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: -
+// Target uC:       -
+// System Clock:    -
+
+// Allocation-free replacements for the snprintf conversions used on hot paths
+// Each function writes at the str pointer, null terminates, and returns a pointer
+// to the terminating null so calls can be chained to build a line:
+//   char str[20];
+//   char* p = formatString(str, "Y = ");
+//   formatSigned(p, y, 8, ' ');
+// The caller sizes str; fields wider than width are never truncated
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+char* formatUnsigned(char* str, uint32_t value, uint8_t width, char pad);
+char* formatSigned(char* str, int32_t value, uint8_t width, char pad);
+char* formatHex(char* str, uint32_t value, uint8_t width, char pad);
+char* formatHexLower(char* str, uint32_t value, uint8_t width, char pad);
+char* formatFixed(char* str, int32_t value, uint8_t decimals, uint8_t width);
+char* formatString(char* str, const char src[]);
+char* formatChar(char* str, char c);
+
+#endif
@@ -0,0 +1,136 @@
+// Formatted Output Benchmark Example
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+// Stack:           4096 bytes (needed for snprintf)
+
+// Hardware configuration:
+// UART Interface:
+//   U0TX (PA1) and U0RX (PA0) are connected to the 2nd controller
+//   The USB on the 2nd controller enumerates to an ICDI interface and a virtual COM port
+//   Configured to 115,200 baud, 8N1
+
+// Compares the cycle counts of newlib snprintf and the format library
+// for the conversions used in the pid, analog, freq_time and i2c_utility examples
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "clock.h"
+#include "uart0.h"
+#include "cycles.h"
+#include "format.h"
+#include "tm4c123gh6pm.h"
+
+#define TEST_COUNT 5
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const int32_t testValues[TEST_COUNT] = {0, 7, -1234, 65535, -2147483647};
+volatile float testFloat = -12.3;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Initialize Hardware
+void initHw()
+{
+    // Initialize system clock to 40 MHz
+    initSystemClockTo40Mhz();
+}
+
+void printResult(const char name[], uint32_t snprintfCycles, uint32_t formatCycles)
+{
+    char str[80];
+    char* p;
+    p = formatString(str, name);
+    p = formatUnsigned(formatString(p, " snprintf: "), snprintfCycles, 6, ' ');
+    p = formatUnsigned(formatString(p, "  format: "), formatCycles, 6, ' ');
+    formatString(p, " (cycles avg)\n");
+    putsUart0(str);
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main(void)
+{
+    char str[40];
+    uint32_t start, snprintfCycles, formatCycles;
+    uint8_t i;
+
+    // Initialize hardware
+    initHw();
+    initUart0();
+    initCycleCounter();
+
+    // Setup UART0 baud rate
+    setUart0BaudRate(115200, 40e6);
+
+    putsUart0("Format Benchmark\n");
+
+    // "%8d"
+    snprintfCycles = formatCycles = 0;
+    for (i = 0; i < TEST_COUNT; i++)
+    {
+        start = getCycleCount();
+        snprintf(str, sizeof(str), "Y = %8"PRId32, testValues[i]);
+        snprintfCycles += getCycleCount() - start;
+        start = getCycleCount();
+        formatSigned(formatString(str, "Y = "), testValues[i], 8, ' ');
+        formatCycles += getCycleCount() - start;
+    }
+    printResult("%8d    ", snprintfCycles / TEST_COUNT, formatCycles / TEST_COUNT);
+
+    // "%04d"
+    snprintfCycles = formatCycles = 0;
+    for (i = 0; i < TEST_COUNT; i++)
+    {
+        start = getCycleCount();
+        snprintf(str, sizeof(str), "%04"PRId32, testValues[i]);
+        snprintfCycles += getCycleCount() - start;
+        start = getCycleCount();
+        formatSigned(str, testValues[i], 4, '0');
+        formatCycles += getCycleCount() - start;
+    }
+    printResult("%04d    ", snprintfCycles / TEST_COUNT, formatCycles / TEST_COUNT);
+
+    // "0x%02X"
+    snprintfCycles = formatCycles = 0;
+    for (i = 0; i < TEST_COUNT; i++)
+    {
+        start = getCycleCount();
+        snprintf(str, sizeof(str), "0x%02"PRIX32, (uint32_t)testValues[i]);
+        snprintfCycles += getCycleCount() - start;
+        start = getCycleCount();
+        formatHex(formatString(str, "0x"), testValues[i], 2, '0');
+        formatCycles += getCycleCount() - start;
+    }
+    printResult("0x%02X   ", snprintfCycles / TEST_COUNT, formatCycles / TEST_COUNT);
+
+    // "%4.1f" (float input versus value already in tenths)
+    start = getCycleCount();
+    snprintf(str, sizeof(str), "%4.1f", testFloat);
+    snprintfCycles = getCycleCount() - start;
+    start = getCycleCount();
+    formatFixed(str, -123, 1, 4);
+    formatCycles = getCycleCount() - start;
+    printResult("%4.1f    ", snprintfCycles, formatCycles);
+
+    while (true);
+}
@@ -8,7 +8,6 @@
 // Target Platform: EK-TM4C123GXL
 // Target uC:       TM4C123GH6PM
 // System Clock:    40 MHz
-// Stack:           4096 bytes (needed for snprintf)
 
 // Hardware configuration:
 // Green LED:
@@ -28,14 +27,13 @@
 // Device includes, defines, and assembler directives
 //-----------------------------------------------------------------------------
 
-#include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdio.h>
 #include <string.h>
 #include "clock.h"
 #include "wait.h"
 #include "uart0.h"
+#include "format.h"
 #include "tm4c123gh6pm.h"
 
 #define RED_LED      (*((volatile uint32_t *)(0x42000000 + (0x400253FC-0x40000000)*32 + 1*4)))
@@ -188,9 +186,9 @@ int main(void)
     while (true)
     {
         if (timeMode)
-            snprintf(str, sizeof(str), "Period:    %7"PRIu32" (us)\n", time / 40);
+            formatString(formatUnsigned(formatString(str, "Period:    "), time / 40, 7, ' '), " (us)\n");
         else
-            snprintf(str, sizeof(str), "Frequency: %7"PRIu32" (Hz)\n", frequency);
+            formatString(formatUnsigned(formatString(str, "Frequency: "), frequency, 7, ' '), " (Hz)\n");
         putsUart0(str);
 
         // debouncing not implemented until keyboard.c example
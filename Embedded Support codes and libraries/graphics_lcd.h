@@ -25,17 +25,31 @@ enum operation
     INVERT
 };
 
+typedef void (*GRAPHICS_LCD_CALLBACK)(void);
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
 void clearGraphicsLcd();
 void initGraphicsLcd();
+void initGraphicsLcdSpiDevice(uint8_t device);
 void drawGraphicsLcdPixel(uint8_t x, uint8_t y, enum operation op);
 void drawGraphicsLcdRectangle(uint8_t xul, uint8_t yul, uint8_t dx, uint8_t dy, enum operation op);
 void setGraphicsLcdTextPosition(uint8_t x, uint8_t page);
 void putcGraphicsLcd(char c);
 void putsGraphicsLcd(char str[]);
+void markGraphicsLcdDirty(uint8_t page, uint8_t x, uint8_t dx);
+void updateGraphicsLcd();
+void setGraphicsLcdDeferred(bool enable);
+bool isGraphicsLcdDeferred();
+void flushGraphicsLcd();
+bool refreshGraphicsLcdDma(GRAPHICS_LCD_CALLBACK callback);
+bool isGraphicsLcdRefreshBusy();
+void startGraphicsLcdRefresh(uint16_t frameRate);
+void stopGraphicsLcdRefresh();
+void swapGraphicsLcdBuffers();
+void graphicsLcdRefreshIsr();
 
 #endif
 
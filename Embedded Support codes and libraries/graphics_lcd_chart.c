@@ -0,0 +1,264 @@
+// Graphics LCD Strip Chart Library
+// Jason Losh
+
+// Strip chart with up to 3 traces
+// Each column keeps the minimum and maximum of the samples it covers, so fast
+// changes remain visible, and is drawn as a vertical span joined to its neighbor
+// In scroll mode, the chart shifts left by one column as each column is completed;
+// columns are rendered into the pixel map and only bytes that changed are marked
+// dirty, so flat traces cost little SPI traffic but sloped traces change most columns
+// In sweep mode, new columns overwrite the oldest ones in place behind a blank
+// column, so only two columns are sent per column regardless of the traces
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL with LCD/Keyboard Interface
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// ST7565R Graphics LCD Display Interface (see graphics_lcd_gpio.c)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "graphics_lcd.h"
+#include "graphics_lcd_chart.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+extern uint8_t pixelMap[1024];
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Initialize a chart covering x to x+width-1, y to y+height-1
+// samplesPerColumn samples are combined into each column
+// Returns false if the chart is empty, shorter than 2 rows, or not on the display
+bool initGraphicsLcdChart(GRAPHICS_LCD_CHART* chart, uint8_t x, uint8_t y, uint8_t width,
+                          uint8_t height, uint8_t traceCount, uint8_t samplesPerColumn)
+{
+    uint8_t i;
+    if ((width == 0) || (width > MAX_CHART_WIDTH) || (x + width > 128)
+        || (height < 2) || (y + height > 64))
+        return false;
+    chart->x = x;
+    chart->y = y;
+    chart->width = width;
+    chart->height = height;
+    chart->traceCount = (traceCount > MAX_CHART_TRACES) ? MAX_CHART_TRACES : traceCount;
+    chart->samplesPerColumn = (samplesPerColumn == 0) ? 1 : samplesPerColumn;
+    for (i = 0; i < chart->traceCount; i++)
+    {
+        chart->trace[i].scaleMin = 0;
+        chart->trace[i].scaleMax = 4095;
+        chart->trace[i].autoscale = false;
+        chart->trace[i].visible = true;
+    }
+    chart->sweep = false;
+    clearGraphicsLcdChart(chart);
+    return true;
+}
+
+// Sets a fixed scale (min at the bottom row and max at the top row)
+void setGraphicsLcdChartScale(GRAPHICS_LCD_CHART* chart, uint8_t trace, int16_t min, int16_t max)
+{
+    chart->trace[trace].scaleMin = min;
+    chart->trace[trace].scaleMax = (max > min) ? max : min + 1;
+    chart->trace[trace].autoscale = false;
+}
+
+// Scales the trace to the range of its history
+void setGraphicsLcdChartAutoscale(GRAPHICS_LCD_CHART* chart, uint8_t trace)
+{
+    chart->trace[trace].autoscale = true;
+}
+
+void setGraphicsLcdChartTraceVisible(GRAPHICS_LCD_CHART* chart, uint8_t trace, bool visible)
+{
+    chart->trace[trace].visible = visible;
+}
+
+// Selects sweep or scroll mode, discarding the history
+void setGraphicsLcdChartSweep(GRAPHICS_LCD_CHART* chart, bool sweep)
+{
+    chart->sweep = sweep;
+    clearGraphicsLcdChart(chart);
+}
+
+// Discards the history and clears the chart area
+void clearGraphicsLcdChart(GRAPHICS_LCD_CHART* chart)
+{
+    chart->head = 0;
+    chart->columnCount = 0;
+    chart->sampleCount = 0;
+    chart->sweepColumn = 0;
+    drawGraphicsLcdChart(chart);
+}
+
+// Updates the scale of autoscaled traces from the history
+// Returns true if a scale changed
+bool updateGraphicsLcdChartScale(GRAPHICS_LCD_CHART* chart)
+{
+    bool changed = false;
+    GRAPHICS_LCD_CHART_TRACE* t;
+    uint8_t i, c, h;
+    int16_t lo, hi;
+    for (i = 0; i < chart->traceCount; i++)
+    {
+        t = &chart->trace[i];
+        if (!t->autoscale || (chart->columnCount == 0))
+            continue;
+        lo = INT16_MAX;
+        hi = INT16_MIN;
+        for (c = 0; c < chart->columnCount; c++)
+        {
+            h = (chart->head + MAX_CHART_WIDTH - 1 - c) % MAX_CHART_WIDTH;
+            if (t->min[h] < lo) lo = t->min[h];
+            if (t->max[h] > hi) hi = t->max[h];
+        }
+        if (hi <= lo)
+            hi = lo + 1;
+        changed |= (t->scaleMin != lo) || (t->scaleMax != hi);
+        t->scaleMin = lo;
+        t->scaleMax = hi;
+    }
+    return changed;
+}
+
+// Returns the row (0 at the top of the chart) of a value
+uint8_t getGraphicsLcdChartRow(GRAPHICS_LCD_CHART* chart, GRAPHICS_LCD_CHART_TRACE* t, int16_t value)
+{
+    int32_t row;
+    if (value <= t->scaleMin)
+        return chart->height - 1;
+    if (value >= t->scaleMax)
+        return 0;
+    row = ((int32_t)(value - t->scaleMin) * (chart->height - 1)) / (t->scaleMax - t->scaleMin);
+    return chart->height - 1 - row;
+}
+
+// Renders one screen column and marks the pages that changed
+void renderGraphicsLcdChartColumn(GRAPHICS_LCD_CHART* chart, uint8_t column)
+{
+    GRAPHICS_LCD_CHART_TRACE* t;
+    uint64_t bits = 0, mask;
+    uint8_t i, age, h, p;
+    uint8_t top, bottom, x;
+    int16_t lo, hi;
+    uint8_t page, firstPage, lastPage, b, m, data;
+    uint16_t index;
+
+    // the newest column is drawn at the right edge, or before the sweep column
+    if (chart->sweep)
+        age = (chart->sweepColumn + 2 * chart->width - 1 - column) % chart->width;
+    else
+        age = chart->width - 1 - column;
+    if ((age < chart->columnCount) && !(chart->sweep && (age == chart->width - 1)))
+    {
+        h = (chart->head + MAX_CHART_WIDTH - 1 - age) % MAX_CHART_WIDTH;
+        p = (h + MAX_CHART_WIDTH - 1) % MAX_CHART_WIDTH;
+        for (i = 0; i < chart->traceCount; i++)
+        {
+            t = &chart->trace[i];
+            if (!t->visible)
+                continue;
+            lo = t->min[h];
+            hi = t->max[h];
+            // join to the previous column
+            if ((age + 1 < chart->columnCount) && !(chart->sweep && (age + 1 == chart->width - 1)))
+            {
+                if (t->max[p] < lo) lo = t->max[p];
+                if (t->min[p] > hi) hi = t->min[p];
+            }
+            top = getGraphicsLcdChartRow(chart, t, hi);
+            bottom = getGraphicsLcdChartRow(chart, t, lo);
+            bits |= ((~0ULL) >> (63 - (bottom - top))) << top;
+        }
+    }
+
+    // write the rows of the chart to the pages of the column
+    x = chart->x + column;
+    mask = (~0ULL) >> (64 - chart->height);
+    bits <<= chart->y & 7;
+    mask <<= chart->y & 7;
+    firstPage = chart->y >> 3;
+    lastPage = (chart->y + chart->height - 1) >> 3;
+    for (page = firstPage; page <= lastPage; page++)
+    {
+        b = bits & 0xFF;
+        m = mask & 0xFF;
+        bits >>= 8;
+        mask >>= 8;
+        index = (page << 7) | x;
+        data = (pixelMap[index] & ~m) | b;
+        if (data != pixelMap[index])
+        {
+            pixelMap[index] = data;
+            markGraphicsLcdDirty(page, x, 1);
+        }
+    }
+}
+
+// Redraws the whole chart (only changed bytes are sent)
+void drawGraphicsLcdChart(GRAPHICS_LCD_CHART* chart)
+{
+    uint8_t column;
+    updateGraphicsLcdChartScale(chart);
+    for (column = 0; column < chart->width; column++)
+        renderGraphicsLcdChartColumn(chart, column);
+    updateGraphicsLcd();
+}
+
+// Adds one sample per trace and returns true if a column was completed and drawn
+bool addGraphicsLcdChartSample(GRAPHICS_LCD_CHART* chart, const int16_t values[])
+{
+    GRAPHICS_LCD_CHART_TRACE* t;
+    uint8_t i;
+    for (i = 0; i < chart->traceCount; i++)
+    {
+        t = &chart->trace[i];
+        if ((chart->sampleCount == 0) || (values[i] < t->pendingMin))
+            t->pendingMin = values[i];
+        if ((chart->sampleCount == 0) || (values[i] > t->pendingMax))
+            t->pendingMax = values[i];
+    }
+    if (++chart->sampleCount < chart->samplesPerColumn)
+        return false;
+
+    // complete the column and scroll
+    chart->sampleCount = 0;
+    for (i = 0; i < chart->traceCount; i++)
+    {
+        t = &chart->trace[i];
+        t->min[chart->head] = t->pendingMin;
+        t->max[chart->head] = t->pendingMax;
+    }
+    chart->head = (chart->head + 1) % MAX_CHART_WIDTH;
+    if (chart->columnCount < chart->width)
+        chart->columnCount++;
+    if (!chart->sweep)
+        drawGraphicsLcdChart(chart);
+    else
+    {
+        // draw the new column and blank the one after it
+        chart->sweepColumn = (chart->sweepColumn + 1) % chart->width;
+        if (updateGraphicsLcdChartScale(chart))
+            drawGraphicsLcdChart(chart);
+        else
+        {
+            renderGraphicsLcdChartColumn(chart, (chart->sweepColumn + chart->width - 1) % chart->width);
+            renderGraphicsLcdChartColumn(chart, chart->sweepColumn);
+            updateGraphicsLcd();
+        }
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+// Graphics LCD Strip Chart Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// ST7565R Graphics LCD Display Interface (see graphics_lcd_gpio.c)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef GRAPHICS_LCD_CHART_H_
+#define GRAPHICS_LCD_CHART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MAX_CHART_TRACES 3
+#define MAX_CHART_WIDTH 128
+
+typedef struct _GRAPHICS_LCD_CHART_TRACE
+{
+    int16_t min[MAX_CHART_WIDTH];      // per column history (ring)
+    int16_t max[MAX_CHART_WIDTH];
+    int16_t pendingMin;                // column being collected
+    int16_t pendingMax;
+    int16_t scaleMin;
+    int16_t scaleMax;
+    bool autoscale;
+    bool visible;
+} GRAPHICS_LCD_CHART_TRACE;
+
+typedef struct _GRAPHICS_LCD_CHART
+{
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;                     // columns (1-128)
+    uint8_t height;                    // rows (2-64)
+    uint8_t traceCount;
+    uint8_t samplesPerColumn;
+    uint8_t sampleCount;
+    uint8_t head;                      // ring index of the next column
+    uint8_t columnCount;               // columns of history
+    bool sweep;                        // overwrite in place instead of scrolling
+    uint8_t sweepColumn;               // screen column of the next column in sweep mode
+    GRAPHICS_LCD_CHART_TRACE trace[MAX_CHART_TRACES];
+} GRAPHICS_LCD_CHART;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+bool initGraphicsLcdChart(GRAPHICS_LCD_CHART* chart, uint8_t x, uint8_t y, uint8_t width,
+                          uint8_t height, uint8_t traceCount, uint8_t samplesPerColumn);
+void setGraphicsLcdChartScale(GRAPHICS_LCD_CHART* chart, uint8_t trace, int16_t min, int16_t max);
+void setGraphicsLcdChartAutoscale(GRAPHICS_LCD_CHART* chart, uint8_t trace);
+void setGraphicsLcdChartTraceVisible(GRAPHICS_LCD_CHART* chart, uint8_t trace, bool visible);
+void setGraphicsLcdChartSweep(GRAPHICS_LCD_CHART* chart, bool sweep);
+void clearGraphicsLcdChart(GRAPHICS_LCD_CHART* chart);
+bool addGraphicsLcdChartSample(GRAPHICS_LCD_CHART* chart, const int16_t values[]);
+void drawGraphicsLcdChart(GRAPHICS_LCD_CHART* chart);
+
+#endif
@@ -0,0 +1,353 @@
+// Graphics LCD Drawing Library
+// Jason Losh
+
+// Lines, circles, polygons, and bitmaps drawn directly on the page-organized
+// pixel map of graphics_lcd_gpio.c (each byte is 8 vertical pixels of a column)
+// Changed columns are marked dirty and sent when each function returns,
+// or by flushGraphicsLcd() in deferred mode
+// Coordinates outside the 128x64 display are clipped
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL with LCD/Keyboard Interface
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// ST7565R Graphics LCD Display Interface (see graphics_lcd_gpio.c)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "graphics_lcd.h"
+#include "graphics_lcd_draw.h"
+
+#define MAX_POLYGON_POINTS 16
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+extern uint8_t pixelMap[1024];
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Applies the operator to the masked bits of a pixel map byte
+void applyGraphicsLcdMask(uint16_t index, uint8_t mask, enum operation op)
+{
+    switch(op)
+    {
+        case CLEAR:  pixelMap[index] &= ~mask; break;
+        case SET:    pixelMap[index] |= mask; break;
+        case INVERT: pixelMap[index] ^= mask; break;
+    }
+}
+
+// Applies the operator to a pixel without clipping or marking
+void applyGraphicsLcdPixel(int16_t x, int16_t y, enum operation op)
+{
+    applyGraphicsLcdMask(((y >> 3) << 7) | x, 1 << (y & 7), op);
+}
+
+bool isGraphicsLcdPixelOnScreen(int16_t x, int16_t y)
+{
+    return (x >= 0) && (x < GRAPHICS_LCD_WIDTH) && (y >= 0) && (y < GRAPHICS_LCD_HEIGHT);
+}
+
+// Marks columns x0-x1 of the pages covering rows y0-y1 (already clipped)
+void markGraphicsLcdArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    uint8_t page;
+    for (page = y0 >> 3; page <= (y1 >> 3); page++)
+        markGraphicsLcdDirty(page, x0, x1 - x0 + 1);
+}
+
+// Horizontal span: one byte operation per column
+void drawGraphicsLcdHLine(int16_t x, int16_t y, int16_t dx, enum operation op)
+{
+    uint16_t index;
+    uint8_t mask;
+    int16_t x1 = x + dx - 1;
+    if ((y < 0) || (y >= GRAPHICS_LCD_HEIGHT) || (dx <= 0))
+        return;
+    if (x < 0)
+        x = 0;
+    if (x1 >= GRAPHICS_LCD_WIDTH)
+        x1 = GRAPHICS_LCD_WIDTH - 1;
+    if (x > x1)
+        return;
+    mask = 1 << (y & 7);
+    index = ((y >> 3) << 7) | x;
+    for (dx = x1 - x + 1; dx > 0; dx--)
+        applyGraphicsLcdMask(index++, mask, op);
+    markGraphicsLcdDirty(y >> 3, x, x1 - x + 1);
+    updateGraphicsLcd();
+}
+
+// Vertical span: one byte operation per page
+void drawGraphicsLcdVLine(int16_t x, int16_t y, int16_t dy, enum operation op)
+{
+    int16_t y1 = y + dy - 1;
+    uint8_t page, firstPage, lastPage, mask;
+    if ((x < 0) || (x >= GRAPHICS_LCD_WIDTH) || (dy <= 0))
+        return;
+    if (y < 0)
+        y = 0;
+    if (y1 >= GRAPHICS_LCD_HEIGHT)
+        y1 = GRAPHICS_LCD_HEIGHT - 1;
+    if (y > y1)
+        return;
+    firstPage = y >> 3;
+    lastPage = y1 >> 3;
+    for (page = firstPage; page <= lastPage; page++)
+    {
+        mask = 0xFF;
+        if (page == firstPage)
+            mask &= 0xFF << (y & 7);
+        if (page == lastPage)
+            mask &= 0xFF >> (7 - (y1 & 7));
+        applyGraphicsLcdMask((page << 7) | x, mask, op);
+        markGraphicsLcdDirty(page, x, 1);
+    }
+    updateGraphicsLcd();
+}
+
+// Bresenham line, including both end points
+void drawGraphicsLcdLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, enum operation op)
+{
+    int16_t dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+    int16_t dy = (y1 > y0) ? y0 - y1 : y1 - y0;
+    int16_t sx = (x0 < x1) ? 1 : -1;
+    int16_t sy = (y0 < y1) ? 1 : -1;
+    int16_t error = dx + dy, e2;
+    int16_t xMin = GRAPHICS_LCD_WIDTH, xMax = -1, yMin = GRAPHICS_LCD_HEIGHT, yMax = -1;
+
+    if (y0 == y1)
+    {
+        drawGraphicsLcdHLine((x0 < x1) ? x0 : x1, y0, dx + 1, op);
+        return;
+    }
+    if (x0 == x1)
+    {
+        drawGraphicsLcdVLine(x0, (y0 < y1) ? y0 : y1, 1 - dy, op);
+        return;
+    }
+    while (true)
+    {
+        if (isGraphicsLcdPixelOnScreen(x0, y0))
+        {
+            applyGraphicsLcdPixel(x0, y0, op);
+            if (x0 < xMin) xMin = x0;
+            if (x0 > xMax) xMax = x0;
+            if (y0 < yMin) yMin = y0;
+            if (y0 > yMax) yMax = y0;
+        }
+        if ((x0 == x1) && (y0 == y1))
+            break;
+        e2 = 2 * error;
+        if (e2 >= dy)
+        {
+            error += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            error += dx;
+            y0 += sy;
+        }
+    }
+    if (xMax >= 0)
+    {
+        markGraphicsLcdArea(xMin, yMin, xMax, yMax);
+        updateGraphicsLcd();
+    }
+}
+
+// Applies the operator to a clipped pixel
+void plotGraphicsLcdPixel(int16_t x, int16_t y, enum operation op)
+{
+    if (isGraphicsLcdPixelOnScreen(x, y))
+        applyGraphicsLcdPixel(x, y, op);
+}
+
+// Midpoint circle
+// Points shared by octants are drawn once so INVERT works
+void drawGraphicsLcdCircle(int16_t xc, int16_t yc, int16_t r, enum operation op)
+{
+    int16_t x = 0, y = r;
+    int16_t d = 1 - r;
+    int16_t x0, y0, x1, y1;
+    if (r < 0)
+        return;
+    if (r == 0)
+        plotGraphicsLcdPixel(xc, yc, op);
+    while (x <= y && r > 0)
+    {
+        if (x == 0)
+        {
+            plotGraphicsLcdPixel(xc, yc + y, op);
+            plotGraphicsLcdPixel(xc, yc - y, op);
+            plotGraphicsLcdPixel(xc + y, yc, op);
+            plotGraphicsLcdPixel(xc - y, yc, op);
+        }
+        else if (x == y)
+        {
+            plotGraphicsLcdPixel(xc + x, yc + y, op);
+            plotGraphicsLcdPixel(xc - x, yc + y, op);
+            plotGraphicsLcdPixel(xc + x, yc - y, op);
+            plotGraphicsLcdPixel(xc - x, yc - y, op);
+        }
+        else
+        {
+            plotGraphicsLcdPixel(xc + x, yc + y, op);
+            plotGraphicsLcdPixel(xc - x, yc + y, op);
+            plotGraphicsLcdPixel(xc + x, yc - y, op);
+            plotGraphicsLcdPixel(xc - x, yc - y, op);
+            plotGraphicsLcdPixel(xc + y, yc + x, op);
+            plotGraphicsLcdPixel(xc - y, yc + x, op);
+            plotGraphicsLcdPixel(xc + y, yc - x, op);
+            plotGraphicsLcdPixel(xc - y, yc - x, op);
+        }
+        x++;
+        if (d < 0)
+            d += 2 * x + 1;
+        else
+        {
+            y--;
+            d += 2 * (x - y) + 1;
+        }
+    }
+
+    // mark the clipped bounding box
+    x0 = (xc - r < 0) ? 0 : xc - r;
+    y0 = (yc - r < 0) ? 0 : yc - r;
+    x1 = (xc + r >= GRAPHICS_LCD_WIDTH) ? GRAPHICS_LCD_WIDTH - 1 : xc + r;
+    y1 = (yc + r >= GRAPHICS_LCD_HEIGHT) ? GRAPHICS_LCD_HEIGHT - 1 : yc + r;
+    if ((x0 <= x1) && (y0 <= y1))
+    {
+        markGraphicsLcdArea(x0, y0, x1, y1);
+        updateGraphicsLcd();
+    }
+}
+
+// Returns the smallest integer not less than n / d
+int16_t ceilGraphicsLcdDivide(int32_t n, int32_t d)
+{
+    if (d < 0)
+    {
+        n = -n;
+        d = -d;
+    }
+    return (n >= 0) ? (n + d - 1) / d : -((-n) / d);
+}
+
+// Scan-line polygon fill using the even-odd rule
+// A pixel is filled if its center is inside the polygon (up to 16 points),
+// so polygons sharing an edge do not overlap
+void fillGraphicsLcdPolygon(const GRAPHICS_LCD_POINT points[], uint8_t count, enum operation op)
+{
+    int16_t crossings[MAX_POLYGON_POINTS];
+    int16_t yMin, yMax, y, x, t;
+    uint8_t i, j, n;
+    const GRAPHICS_LCD_POINT *a, *b;
+    bool deferredDraw;
+
+    if ((count < 3) || (count > MAX_POLYGON_POINTS))
+        return;
+    yMin = yMax = points[0].y;
+    for (i = 1; i < count; i++)
+    {
+        if (points[i].y < yMin) yMin = points[i].y;
+        if (points[i].y > yMax) yMax = points[i].y;
+    }
+    if (yMin < 0)
+        yMin = 0;
+    if (yMax >= GRAPHICS_LCD_HEIGHT)
+        yMax = GRAPHICS_LCD_HEIGHT - 1;
+
+    // collect the spans of all rows before sending
+    deferredDraw = isGraphicsLcdDeferred();
+    setGraphicsLcdDeferred(true);
+    for (y = yMin; y <= yMax; y++)
+    {
+        // find the first pixel right of each edge crossing at the row center (y + 0.5)
+        n = 0;
+        for (i = 0, j = count - 1; i < count; j = i++)
+        {
+            a = &points[i];
+            b = &points[j];
+            if ((a->y <= y) != (b->y <= y))
+            {
+                // x = ceil(a.x + (y + 0.5 - a.y) * (b.x - a.x) / (b.y - a.y) - 0.5)
+                x = a->x + ceilGraphicsLcdDivide((int32_t)(2 * (y - a->y) + 1) * (b->x - a->x)
+                                                 - (b->y - a->y), 2 * (b->y - a->y));
+                crossings[n++] = x;
+            }
+        }
+        // sort crossings (few points, so insertion sort)
+        for (i = 1; i < n; i++)
+        {
+            t = crossings[i];
+            for (j = i; (j > 0) && (crossings[j - 1] > t); j--)
+                crossings[j] = crossings[j - 1];
+            crossings[j] = t;
+        }
+        for (i = 0; i + 1 < n; i += 2)
+            drawGraphicsLcdHLine(crossings[i], y, crossings[i + 1] - crossings[i], op);
+    }
+    setGraphicsLcdDeferred(deferredDraw);
+    updateGraphicsLcd();
+}
+
+// Draws a page-organized 1-bpp bitmap (columns of 8 vertical pixels,
+// ((height + 7) / 8) rows of width bytes) with its top left corner at (x, y)
+// Each source byte is shifted into two destination pages as a 16-bit word
+// Set bits of the bitmap are set, cleared, or inverted on the display
+void drawGraphicsLcdBitmap(int16_t x, int16_t y, const uint8_t bitmap[], uint8_t width,
+                           uint8_t height, enum operation op)
+{
+    uint8_t sourcePages = (height + 7) >> 3;
+    uint8_t shift = y & 7;
+    uint8_t row, lastMask;
+    int16_t column, page, xs;
+    uint16_t word;
+    int16_t x0 = GRAPHICS_LCD_WIDTH, x1 = -1;
+
+    if ((height == 0) || (width == 0))
+        return;
+    lastMask = 0xFF >> ((8 - (height & 7)) & 7);       // rows of the last source page
+    for (row = 0; row < sourcePages; row++)
+    {
+        page = ((y < 0) ? (y - 7) / 8 : y / 8) + row;  // page above the display for negative y
+        for (column = 0; column < width; column++)
+        {
+            xs = x + column;
+            if ((xs < 0) || (xs >= GRAPHICS_LCD_WIDTH))
+                continue;
+            word = bitmap[row * width + column];
+            if (row == sourcePages - 1)
+                word &= lastMask;
+            word <<= shift;
+            if ((page >= 0) && (page < 8) && (word & 0xFF))
+                applyGraphicsLcdMask((page << 7) | xs, word & 0xFF, op);
+            if ((page + 1 >= 0) && (page + 1 < 8) && (word >> 8))
+                applyGraphicsLcdMask(((page + 1) << 7) | xs, word >> 8, op);
+            if (xs < x0) x0 = xs;
+            if (xs > x1) x1 = xs;
+        }
+    }
+    if (x1 >= 0)
+    {
+        for (page = 0; page < 8; page++)
+            if ((page * 8 + 7 >= y) && (page * 8 < y + height))
+                markGraphicsLcdDirty(page, x0, x1 - x0 + 1);
+        updateGraphicsLcd();
+    }
+}
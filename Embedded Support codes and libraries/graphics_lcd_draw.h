@@ -0,0 +1,42 @@
+// Graphics LCD Drawing Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// ST7565R Graphics LCD Display Interface (see graphics_lcd_gpio.c)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef GRAPHICS_LCD_DRAW_H_
+#define GRAPHICS_LCD_DRAW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "graphics_lcd.h"
+
+#define GRAPHICS_LCD_WIDTH  128
+#define GRAPHICS_LCD_HEIGHT 64
+
+typedef struct _GRAPHICS_LCD_POINT
+{
+    int16_t x;
+    int16_t y;
+} GRAPHICS_LCD_POINT;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void drawGraphicsLcdHLine(int16_t x, int16_t y, int16_t dx, enum operation op);
+void drawGraphicsLcdVLine(int16_t x, int16_t y, int16_t dy, enum operation op);
+void drawGraphicsLcdLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, enum operation op);
+void drawGraphicsLcdCircle(int16_t xc, int16_t yc, int16_t r, enum operation op);
+void fillGraphicsLcdPolygon(const GRAPHICS_LCD_POINT points[], uint8_t count, enum operation op);
+void drawGraphicsLcdBitmap(int16_t x, int16_t y, const uint8_t bitmap[], uint8_t width,
+                           uint8_t height, enum operation op);
+
+#endif
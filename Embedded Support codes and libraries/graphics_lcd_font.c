@@ -0,0 +1,296 @@
+// Graphics LCD Font Library
+// Jason Losh
+
+// Text at any pixel position, with proportional or fixed width fonts scaled 1x-3x
+// Each glyph column is scaled and shifted to the row once, then written to up to
+// four pages of the pixel map for each of its scaled columns
+// Operators: SET draws the glyph over a cleared cell, CLEAR draws it inverted
+// over a set cell, and INVERT toggles the glyph pixels only
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL with LCD/Keyboard Interface
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// ST7565R Graphics LCD Display Interface (see graphics_lcd_gpio.c)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "graphics_lcd.h"
+#include "graphics_lcd_font.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+extern uint8_t pixelMap[1024];
+extern const uint8_t charGen[100][5];
+
+// Proportional 5x7 font (codes 32-130)
+// Columns of charGen with blank columns removed; digits keep a fixed width
+const uint8_t font5x7Data[438] =
+{
+    0x00, 0x00,                      // space
+    0x4F,                            // !
+    0x07, 0x00, 0x07,                // "
+    0x14, 0x7F, 0x14, 0x7F, 0x14,    // #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,    // $
+    0x23, 0x13, 0x08, 0x64, 0x62,    // %
+    0x36, 0x49, 0x55, 0x22, 0x40,    // &
+    0x05, 0x03,                      // '
+    0x1C, 0x22, 0x41,                // (
+    0x41, 0x22, 0x1C,                // )
+    0x14, 0x08, 0x3E, 0x08, 0x14,    // *
+    0x08, 0x08, 0x3E, 0x08, 0x08,    // +
+    0x50, 0x30,                      // ,
+    0x08, 0x08, 0x08, 0x08, 0x08,    // -
+    0x60, 0x60,                      // .
+    0x20, 0x10, 0x08, 0x04, 0x02,    // /
+    0x3E, 0x51, 0x49, 0x45, 0x3E,    // 0
+    0x00, 0x42, 0x7F, 0x40, 0x00,    // 1
+    0x42, 0x61, 0x51, 0x49, 0x46,    // 2
+    0x21, 0x41, 0x45, 0x4B, 0x31,    // 3
+    0x18, 0x14, 0x12, 0x7F, 0x10,    // 4
+    0x27, 0x45, 0x45, 0x45, 0x39,    // 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30,    // 6
+    0x01, 0x71, 0x09, 0x05, 0x03,    // 7
+    0x36, 0x49, 0x49, 0x49, 0x36,    // 8
+    0x06, 0x49, 0x49, 0x29, 0x1E,    // 9
+    0x36, 0x36,                      // :
+    0x56, 0x36,                      // ;
+    0x08, 0x14, 0x22, 0x41,          // <
+    0x14, 0x14, 0x14, 0x14, 0x14,    // =
+    0x41, 0x22, 0x14, 0x08,          // >
+    0x02, 0x01, 0x51, 0x09, 0x3E,    // ?
+    0x32, 0x49, 0x79, 0x41, 0x3E,    // @
+    0x7E, 0x11, 0x11, 0x11, 0x7E,    // A
+    0x7F, 0x49, 0x49, 0x49, 0x36,    // B
+    0x3E, 0x41, 0x41, 0x41, 0x22,    // C
+    0x7F, 0x41, 0x41, 0x22, 0x1C,    // D
+    0x7F, 0x49, 0x49, 0x49, 0x41,    // E
+    0x7F, 0x09, 0x09, 0x09, 0x01,    // F
+    0x3E, 0x41, 0x49, 0x49, 0x3A,    // G
+    0x7F, 0x08, 0x08, 0x08, 0x7F,    // H
+    0x41, 0x7F, 0x41,                // I
+    0x20, 0x40, 0x41, 0x3F, 0x01,    // J
+    0x7F, 0x08, 0x14, 0x22, 0x41,    // K
+    0x7F, 0x40, 0x40, 0x40, 0x40,    // L
+    0x7F, 0x02, 0x0C, 0x02, 0x7F,    // M
+    0x7F, 0x04, 0x08, 0x10, 0x7F,    // N
+    0x3E, 0x41, 0x41, 0x41, 0x3E,    // O
+    0x7F, 0x09, 0x09, 0x09, 0x06,    // P
+    0x3E, 0x41, 0x51, 0x21, 0x5E,    // Q
+    0x7F, 0x09, 0x19, 0x29, 0x46,    // R
+    0x46, 0x49, 0x49, 0x49, 0x31,    // S
+    0x01, 0x01, 0x7F, 0x01, 0x01,    // T
+    0x3F, 0x40, 0x40, 0x40, 0x3F,    // U
+    0x1F, 0x20, 0x40, 0x20, 0x1F,    // V
+    0x3F, 0x40, 0x70, 0x40, 0x3F,    // W
+    0x63, 0x14, 0x08, 0x14, 0x63,    // X
+    0x07, 0x08, 0x70, 0x08, 0x07,    // Y
+    0x61, 0x51, 0x49, 0x45, 0x43,    // Z
+    0x7F, 0x41, 0x41,                // [
+    0x02, 0x04, 0x08, 0x10, 0x20,    // backslash
+    0x41, 0x41, 0x7F,                // ]
+    0x04, 0x02, 0x01, 0x02, 0x04,    // ^
+    0x40, 0x40, 0x40, 0x40, 0x40,    // _
+    0x01, 0x02, 0x04,                // `
+    0x20, 0x54, 0x54, 0x54, 0x78,    // a
+    0x7F, 0x44, 0x44, 0x44, 0x38,    // b
+    0x38, 0x44, 0x44, 0x44, 0x20,    // c
+    0x38, 0x44, 0x44, 0x48, 0x7F,    // d
+    0x38, 0x54, 0x54, 0x54, 0x18,    // e
+    0x08, 0x7E, 0x09, 0x01, 0x02,    // f
+    0x0C, 0x52, 0x52, 0x52, 0x3E,    // g
+    0x7F, 0x08, 0x04, 0x04, 0x78,    // h
+    0x44, 0x7D, 0x40,                // i
+    0x20, 0x40, 0x44, 0x3D,          // j
+    0x7F, 0x10, 0x28, 0x44,          // k
+    0x41, 0x7F, 0x40,                // l
+    0x7C, 0x04, 0x18, 0x04, 0x78,    // m
+    0x7C, 0x08, 0x04, 0x04, 0x78,    // n
+    0x38, 0x44, 0x44, 0x44, 0x38,    // o
+    0x7C, 0x14, 0x14, 0x14, 0x08,    // p
+    0x08, 0x14, 0x14, 0x18, 0x7C,    // q
+    0x7C, 0x08, 0x04, 0x04, 0x08,    // r
+    0x48, 0x54, 0x54, 0x54, 0x20,    // s
+    0x04, 0x3F, 0x44, 0x40, 0x20,    // t
+    0x3C, 0x40, 0x40, 0x20, 0x7C,    // u
+    0x1C, 0x20, 0x40, 0x20, 0x1C,    // v
+    0x3C, 0x40, 0x20, 0x40, 0x3C,    // w
+    0x44, 0x28, 0x10, 0x28, 0x44,    // x
+    0x0C, 0x50, 0x50, 0x50, 0x3C,    // y
+    0x44, 0x64, 0x54, 0x4C, 0x44,    // z
+    0x08, 0x36, 0x41,                // {
+    0x7F,                            // |
+    0x41, 0x36, 0x08,                // }
+    0x0C, 0x04, 0x1C, 0x10, 0x18,    // ~
+    0x00, 0x00,                      // (unused)
+    0x08, 0x08, 0x2A, 0x1C, 0x08,    // right arrow
+    0x08, 0x1C, 0x2A, 0x08, 0x08,    // left arrow
+    0x07, 0x05, 0x07,                // degree sign
+};
+
+const uint16_t font5x7Offset[99] =
+{
+    0, 2, 3, 6, 11, 16, 21, 26, 28, 31, 34, 39,
+    44, 46, 51, 53, 58, 63, 68, 73, 78, 83, 88, 93,
+    98, 103, 108, 110, 112, 116, 121, 125, 130, 135, 140, 145,
+    150, 155, 160, 165, 170, 175, 178, 183, 188, 193, 198, 203,
+    208, 213, 218, 223, 228, 233, 238, 243, 248, 253, 258, 263,
+    266, 271, 274, 279, 284, 287, 292, 297, 302, 307, 312, 317,
+    322, 327, 330, 334, 338, 341, 346, 351, 356, 361, 366, 371,
+    376, 381, 386, 391, 396, 401, 406, 411, 414, 415, 418, 423,
+    425, 430, 435,
+};
+
+const uint8_t font5x7Width[99] =
+{
+    2, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+    3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5, 2,
+    5, 5, 3,
+};
+
+const GRAPHICS_LCD_FONT font5x7 = {7, 32, 99, 1, 0, font5x7Data, font5x7Offset, font5x7Width};
+const GRAPHICS_LCD_FONT font5x7Fixed = {7, 32, 99, 1, 5, &charGen[0][0], 0, 0};
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Repeats each bit of a column scale times (bit 0 stays at the top)
+uint32_t scaleGraphicsLcdColumn(uint8_t bits, uint8_t scale)
+{
+    uint32_t column = 0;
+    uint8_t i;
+    if (scale == 1)
+        return bits;
+    for (i = 0; i < 8; i++)
+        if (bits & (1 << i))
+            column |= ((1 << scale) - 1) << (i * scale);
+    return column;
+}
+
+// Writes a shifted column to the pages starting at page
+// mask covers the character cell and bits the glyph pixels within it
+void writeGraphicsLcdColumn(int16_t x, int8_t page, uint32_t bits, uint32_t mask, enum operation op)
+{
+    uint16_t index;
+    uint8_t b, m;
+    if ((x < 0) || (x >= 128))
+        return;
+    for (; mask != 0; page++, bits >>= 8, mask >>= 8)
+    {
+        if ((page < 0) || (page >= 8))
+            continue;
+        index = (page << 7) | x;
+        b = bits & 0xFF;
+        m = mask & 0xFF;
+        switch(op)
+        {
+            case SET:    pixelMap[index] = (pixelMap[index] & ~m) | b; break;
+            case CLEAR:  pixelMap[index] = (pixelMap[index] & ~m) | (m & ~b); break;
+            case INVERT: pixelMap[index] ^= b; break;
+        }
+    }
+}
+
+// Returns the glyph index of a character, using '?' for codes not in the font
+uint8_t getGraphicsLcdGlyph(char c, const GRAPHICS_LCD_FONT* font)
+{
+    uint8_t uc = (uint8_t)c;
+    if ((uc < font->first) || (uc - font->first >= font->count))
+        uc = ((uint8_t)'?' - font->first < font->count) ? '?' : font->first;
+    return uc - font->first;
+}
+
+uint8_t getGraphicsLcdGlyphWidth(uint8_t glyph, const GRAPHICS_LCD_FONT* font)
+{
+    return font->width ? font->width[glyph] : font->fixedWidth;
+}
+
+// Draws a character with its top left corner at (x, y) and returns its advance in pixels
+uint8_t drawGraphicsLcdChar(int16_t x, int16_t y, char c, const GRAPHICS_LCD_FONT* font,
+                            uint8_t scale, enum operation op)
+{
+    uint8_t glyph, width, column, i;
+    const uint8_t* data;
+    uint32_t bits, mask;
+    int16_t page, shift, x0, x1, y1;
+    uint8_t advance;
+
+    if (scale < 1)
+        scale = 1;
+    if (scale > MAX_FONT_SCALE)
+        scale = MAX_FONT_SCALE;
+    glyph = getGraphicsLcdGlyph(c, font);
+    width = getGraphicsLcdGlyphWidth(glyph, font);
+    data = font->data + (font->offset ? font->offset[glyph] : glyph * font->fixedWidth);
+    advance = (width + font->spacing) * scale;
+
+    // page and bit position of the top row (rounding down for negative rows)
+    page = (y < 0) ? (y - 7) / 8 : y / 8;
+    shift = y - page * 8;
+    mask = ((1UL << (font->height * scale)) - 1) << shift;
+
+    for (column = 0; column < width + font->spacing; column++)
+    {
+        bits = (column < width) ? data[column] & ((1 << font->height) - 1) : 0;
+        bits = scaleGraphicsLcdColumn(bits, scale) << shift;
+        for (i = 0; i < scale; i++)
+            writeGraphicsLcdColumn(x + column * scale + i, page, bits, mask, op);
+    }
+
+    // mark the clipped cell
+    x0 = (x < 0) ? 0 : x;
+    x1 = (x + advance > 128) ? 127 : x + advance - 1;
+    y1 = y + font->height * scale - 1;
+    if (y1 > 63)
+        y1 = 63;
+    for (page = (y < 0) ? 0 : y >> 3; (page <= (y1 >> 3)) && (x0 <= x1) && (y1 >= 0); page++)
+        markGraphicsLcdDirty(page, x0, x1 - x0 + 1);
+    updateGraphicsLcd();
+    return advance;
+}
+
+// Draws a string and returns the x position following it
+// The spans of all characters are sent together
+int16_t drawGraphicsLcdText(int16_t x, int16_t y, const char str[], const GRAPHICS_LCD_FONT* font,
+                            uint8_t scale, enum operation op)
+{
+    bool deferredDraw = isGraphicsLcdDeferred();
+    uint8_t i = 0;
+    setGraphicsLcdDeferred(true);
+    while ((str[i] != 0) && (x < 128))
+        x += drawGraphicsLcdChar(x, y, str[i++], font, scale, op);
+    setGraphicsLcdDeferred(deferredDraw);
+    updateGraphicsLcd();
+    return x;
+}
+
+// Returns the width of a string in pixels, including the spacing after the last character
+uint16_t getGraphicsLcdTextWidth(const char str[], const GRAPHICS_LCD_FONT* font, uint8_t scale)
+{
+    uint16_t width = 0;
+    uint8_t i = 0;
+    if (scale < 1)
+        scale = 1;
+    if (scale > MAX_FONT_SCALE)
+        scale = MAX_FONT_SCALE;
+    while (str[i] != 0)
+        width += (getGraphicsLcdGlyphWidth(getGraphicsLcdGlyph(str[i++], font), font)
+                  + font->spacing) * scale;
+    return width;
+}
@@ -0,0 +1,51 @@
+// Graphics LCD Font Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// ST7565R Graphics LCD Display Interface (see graphics_lcd_gpio.c)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef GRAPHICS_LCD_FONT_H_
+#define GRAPHICS_LCD_FONT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "graphics_lcd.h"
+
+#define MAX_FONT_SCALE 3
+
+// Glyphs are stored as columns of up to 8 pixels (bit 0 at the top)
+// Proportional fonts list the offset and width of each glyph; fixed width
+// fonts set offset and width to 0 and store fixedWidth columns per glyph
+typedef struct _GRAPHICS_LCD_FONT
+{
+    uint8_t height;                    // rows (1-8)
+    uint8_t first;                     // first character code
+    uint8_t count;                     // number of glyphs
+    uint8_t spacing;                   // blank columns after each glyph
+    uint8_t fixedWidth;
+    const uint8_t* data;
+    const uint16_t* offset;
+    const uint8_t* width;
+} GRAPHICS_LCD_FONT;
+
+extern const GRAPHICS_LCD_FONT font5x7;
+extern const GRAPHICS_LCD_FONT font5x7Fixed;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+uint8_t drawGraphicsLcdChar(int16_t x, int16_t y, char c, const GRAPHICS_LCD_FONT* font,
+                            uint8_t scale, enum operation op);
+int16_t drawGraphicsLcdText(int16_t x, int16_t y, const char str[], const GRAPHICS_LCD_FONT* font,
+                            uint8_t scale, enum operation op);
+uint16_t getGraphicsLcdTextWidth(const char str[], const GRAPHICS_LCD_FONT* font, uint8_t scale);
+
+#endif
@@ -1,6 +1,11 @@
 // Graphics LCD Library
 // Jason Losh
 
+// For background refresh, hook in graphicsLcdRefreshIsr to TIMER3A IVT entry
+// The display is driven either on a dedicated SPI1 (initGraphicsLcd) or as a device
+// of the spi.c bus manager (initGraphicsLcdSpiDevice), so it can share a bus with
+// other SPI devices; uDMA and background refresh need the dedicated SPI1
+
 //-----------------------------------------------------------------------------
 // Hardware Target
 //-----------------------------------------------------------------------------
@@ -27,10 +32,17 @@
 #include "graphics_lcd.h"
 #include "gpio.h"
 #include "spi1.h"
+#include "spi.h"
+#include "nvic.h"
 
 // Pins
 #define A0 PORTD,2
 
+#define SYSTEM_CLOCK 40000000
+
+// Characters defined in charGen (codes 32-130)
+#define CHARGEN_COUNT 99
+
 //-----------------------------------------------------------------------------
 // Global variables
 //-----------------------------------------------------------------------------
@@ -38,6 +50,34 @@
 uint8_t  pixelMap[1024];
 uint16_t txtIndex = 0;
 
+// A0 level of the frames in the SPI fifo (0xFF until first set)
+uint8_t a0Level = 0xFF;
+
+// Bus manager device handle, or SPI_INVALID_DEVICE when using the dedicated SPI1
+uint8_t lcdSpiDevice = SPI_INVALID_DEVICE;
+
+// Deferred drawing: columns [dirtyStart, dirtyEnd) of each of the dirtyCount spans
+// of a page may differ from the display
+// Spans are kept in order and merged when at most DIRTY_GAP columns apart, since
+// starting another run on the same page costs two column address commands
+#define DIRTY_SPANS 8
+#define DIRTY_GAP 2
+bool deferred = false;
+uint8_t dirtyCount[8];
+uint8_t dirtyStart[8][DIRTY_SPANS + 1];
+uint8_t dirtyEnd[8][DIRTY_SPANS + 1];
+
+// uDMA refresh: page address commands and data for each page
+uint8_t pageCommands[8][3];
+SPI1_SEGMENT refreshSegments[16];
+
+// panelMap holds what has been sent to the display, so only changed columns are flushed
+// Background refresh: drawing goes to pixelMap (back buffer), swapped frames are
+// copied to frontMap, and the refresh sends the differences to panelMap
+uint8_t frontMap[1024];
+uint8_t panelMap[1024];
+bool backgroundRefresh = false;
+
 // 96 character 5x7 bitmaps based on ISO-646 (BCT IRV extensions)
 const uint8_t charGen[100][5] = {
     // Codes 32-127
@@ -155,18 +195,83 @@ const uint8_t charGen[100][5] = {
 // Subroutines
 //-----------------------------------------------------------------------------
 
-// Blocking function that writes data to the SPI bus and waits for the data to complete transmission
+// Segment and transaction callbacks run with the SPI bus idle
+void selectGraphicsLcdCommand()
+{
+    setPinValue(A0, 0);
+    a0Level = 0;
+}
+
+void selectGraphicsLcdData()
+{
+    setPinValue(A0, 1);
+    a0Level = 1;
+}
+
+// Blocking function that sends frames as one bus manager transaction
+// A0 is set by the before callback once the bus is idle, so transactions of
+// other devices queued ahead of this one are not affected
+void sendGraphicsLcdSpiTransaction(const uint8_t data[], uint16_t size, uint8_t level)
+{
+    SPI_TRANSACTION transaction;
+    memset(&transaction, 0, sizeof(transaction));
+    transaction.device = lcdSpiDevice;
+    transaction.txData = data;
+    transaction.size = size;
+    transaction.before = level ? selectGraphicsLcdData : selectGraphicsLcdCommand;
+    while (!queueSpiTransaction(&transaction));
+    while (!transaction.done);
+}
+
+// Sets A0 (0 for commands, 1 for data) for the following frames
+// A0 is only changed at a command/data boundary, after the frames already in
+// the fifo have been sent, so runs of commands or data stream without waiting
+void selectGraphicsLcdA0(uint8_t level)
+{
+    if (a0Level != level)
+    {
+        waitSpi1Idle();
+        setPinValue(A0, level);
+        a0Level = level;
+    }
+}
+
+// Function that queues a command in the SPI tx fifo, waiting only if the fifo is full
 void sendGraphicsLcdCommand(uint8_t command)
 {
-	setPinValue(A0, 0);                // clear A0 for commands
-	writeSpi1Data(command);
+    if (lcdSpiDevice != SPI_INVALID_DEVICE)
+    {
+        sendGraphicsLcdSpiTransaction(&command, 1, 0);
+        return;
+    }
+    selectGraphicsLcdA0(0);
+    putSpi1Data(command);
 }
 
-// Blocking function that writes data to the SPI bus and waits for the data to complete transmission
+// Function that queues data in the SPI tx fifo, waiting only if the fifo is full
 void sendGraphicsLcdData(uint8_t data)
 {
-	setPinValue(A0, 1);                // set A0 for data
-	writeSpi1Data(data);
+    if (lcdSpiDevice != SPI_INVALID_DEVICE)
+    {
+        sendGraphicsLcdSpiTransaction(&data, 1, 1);
+        return;
+    }
+    selectGraphicsLcdA0(1);
+    putSpi1Data(data);
+}
+
+// Function that queues a block of data in the SPI tx fifo as space is available
+void sendGraphicsLcdDataBlock(const uint8_t data[], uint16_t size)
+{
+    uint16_t i;
+    if (lcdSpiDevice != SPI_INVALID_DEVICE)
+    {
+        sendGraphicsLcdSpiTransaction(data, size, 1);
+        return;
+    }
+    selectGraphicsLcdA0(1);
+    for (i = 0; i < size; i++)
+        putSpi1Data(data[i]);
 }
 
 void setGraphicsLcdPage(uint8_t page)
@@ -180,17 +285,291 @@ void setGraphicsLcdColumn(uint8_t x)
   sendGraphicsLcdCommand(0x00 | (x & 0x0F));
 }
 
+// Adds columns x to x+dx-1 to the dirty spans of a page, merging the spans within
+// DIRTY_GAP columns of them
+// When all spans are in use, the two closest spans are joined
+void markGraphicsLcdDirty(uint8_t page, uint8_t x, uint8_t dx)
+{
+    uint8_t* start = dirtyStart[page];
+    uint8_t* end = dirtyEnd[page];
+    uint8_t count = dirtyCount[page];
+    uint8_t x1 = (x + dx > 128) ? 128 : x + dx;
+    uint8_t first, last, i, gap, minGap;
+    if (x >= x1)
+        return;
+    for (first = 0; first < count && end[first] + DIRTY_GAP < x; first++);
+    for (last = first; last < count && start[last] <= x1 + DIRTY_GAP; last++)
+    {
+        if (start[last] < x)
+            x = start[last];
+        if (end[last] > x1)
+            x1 = end[last];
+    }
+    // spans first to last-1 are replaced by the new span
+    if (last == first)
+    {
+        for (i = count; i > first; i--)
+        {
+            start[i] = start[i - 1];
+            end[i] = end[i - 1];
+        }
+        count++;
+    }
+    else
+    {
+        for (i = last; i < count; i++)
+        {
+            start[i - (last - first) + 1] = start[i];
+            end[i - (last - first) + 1] = end[i];
+        }
+        count -= last - first - 1;
+    }
+    start[first] = x;
+    end[first] = x1;
+    if (count > DIRTY_SPANS)
+    {
+        minGap = 0xFF;
+        for (i = 0; i + 1 < count; i++)
+        {
+            gap = start[i + 1] - end[i];
+            if (gap < minGap)
+            {
+                minGap = gap;
+                first = i;
+            }
+        }
+        end[first] = end[first + 1];
+        for (i = first + 1; i + 1 < count; i++)
+        {
+            start[i] = start[i + 1];
+            end[i] = end[i + 1];
+        }
+        count--;
+    }
+    dirtyCount[page] = count;
+}
+
+bool isGraphicsLcdDeferred()
+{
+    return deferred;
+}
+
+// Sends the dirty spans unless in deferred mode
+void updateGraphicsLcd()
+{
+    if (!deferred)
+        flushGraphicsLcd();
+}
+
+// In deferred mode, drawing only updates the pixel map until flushGraphicsLcd() is called
+void setGraphicsLcdDeferred(bool enable)
+{
+    deferred = enable;
+}
+
+// Sends the columns of the dirty spans that differ from the display, with one page
+// setup per page and one column setup per run
+// Changed columns at most DIRTY_GAP clean columns apart are sent as one run, since
+// the clean columns cost no more than the column setup
+void flushGraphicsLcd()
+{
+    uint8_t page, i, x, x1, clean, end;
+    uint16_t base;
+    bool pageSet;
+    for (page = 0; page < 8; page++)
+    {
+        base = page << 7;
+        pageSet = false;
+        for (i = 0; i < dirtyCount[page]; i++)
+        {
+            x = dirtyStart[page][i];
+            end = dirtyEnd[page][i];
+            while (x < end)
+            {
+                if (pixelMap[base + x] == panelMap[base + x])
+                {
+                    x++;
+                    continue;
+                }
+                // extend the run to the last change before more than DIRTY_GAP clean columns
+                x1 = x + 1;
+                for (clean = 0; (x1 + clean < end) && (clean <= DIRTY_GAP); )
+                {
+                    if (pixelMap[base + x1 + clean] != panelMap[base + x1 + clean])
+                    {
+                        x1 += clean + 1;
+                        clean = 0;
+                    }
+                    else
+                        clean++;
+                }
+                if (!pageSet)
+                {
+                    setGraphicsLcdPage(page);
+                    pageSet = true;
+                }
+                setGraphicsLcdColumn(x);
+                memcpy(&panelMap[base + x], &pixelMap[base + x], x1 - x);
+                sendGraphicsLcdDataBlock(&pixelMap[base + x], x1 - x);
+                x = x1;
+            }
+        }
+        dirtyCount[page] = 0;
+    }
+}
+
 void refreshGraphicsLcd()
 {
-    uint8_t x, page;
-    uint16_t i = 0;
+    uint8_t page;
     for (page = 0; page < 8; page ++)
     {
+        dirtyCount[page] = 0;
     	setGraphicsLcdPage(page);
         setGraphicsLcdColumn(0);
-        for (x = 0; x < 128; x++)
-    	    sendGraphicsLcdData(pixelMap[i++]);
+        sendGraphicsLcdDataBlock(&pixelMap[page << 7], 128);
+    }
+    memcpy(panelMap, pixelMap, sizeof(panelMap));
+}
+
+// Non-blocking function that copies the pixel map to the display using uDMA
+// Returns false if a refresh is still in progress or the display is on the bus manager
+// The blocking functions must not be used until the callback is called
+// initUdma() and initSpi1Dma() must be called first
+bool refreshGraphicsLcdDma(GRAPHICS_LCD_CALLBACK callback)
+{
+    uint8_t page;
+    if (isSpi1DmaBusy() || (lcdSpiDevice != SPI_INVALID_DEVICE))
+        return false;
+    waitSpi1Idle();                                    // finish frames queued by other functions
+    for (page = 0; page < 8; page++)
+    {
+        pageCommands[page][0] = 0xB0 | page;           // page
+        pageCommands[page][1] = 0x10;                  // column 0
+        pageCommands[page][2] = 0x00;
+        refreshSegments[2*page].data = pageCommands[page];
+        refreshSegments[2*page].size = 3;
+        refreshSegments[2*page].before = selectGraphicsLcdCommand;
+        refreshSegments[2*page+1].data = &pixelMap[page << 7];
+        refreshSegments[2*page+1].size = 128;
+        refreshSegments[2*page+1].before = selectGraphicsLcdData;
+        dirtyCount[page] = 0;
     }
+    memcpy(panelMap, pixelMap, sizeof(panelMap));
+    return writeSpi1DmaSegments(refreshSegments, 16, callback);
+}
+
+bool isGraphicsLcdRefreshBusy()
+{
+    return isSpi1DmaBusy();
+}
+
+// Starts a TIMER3A refresh at frameRate frames per second that sends the differences
+// between the last swapped frame and the display using uDMA
+// Drawing is deferred to the back buffer until swapGraphicsLcdBuffers() is called
+// initUdma() and initSpi1Dma() must be called first
+// Not available on the bus manager, where drawing stays immediate
+// A frameRate of 0 stops a running refresh
+void startGraphicsLcdRefresh(uint16_t frameRate)
+{
+    if (frameRate == 0)
+    {
+        if (backgroundRefresh)
+            stopGraphicsLcdRefresh();
+        return;
+    }
+    if (lcdSpiDevice != SPI_INVALID_DEVICE)
+        return;
+    // Bring the display up to date
+    flushGraphicsLcd();
+    waitSpi1Idle();
+    memcpy(panelMap, pixelMap, sizeof(panelMap));
+    memcpy(frontMap, pixelMap, sizeof(frontMap));
+    deferred = true;
+    backgroundRefresh = true;
+
+    // Enable clocks
+    SYSCTL_RCGCTIMER_R |= SYSCTL_RCGCTIMER_R3;
+    _delay_cycles(3);
+
+    // Configure Timer 3 for the refresh rate
+    TIMER3_CTL_R &= ~TIMER_CTL_TAEN;                 // turn-off timer before reconfiguring
+    TIMER3_CFG_R = TIMER_CFG_32_BIT_TIMER;           // configure as 32-bit timer (A+B)
+    TIMER3_TAMR_R = TIMER_TAMR_TAMR_PERIOD;          // configure for periodic mode (count down)
+    TIMER3_TAILR_R = SYSTEM_CLOCK / frameRate;       // set load value for the frame rate
+    TIMER3_IMR_R = TIMER_IMR_TATOIM;                 // turn-on interrupts
+    enableNvicInterrupt(INT_TIMER3A);
+    TIMER3_CTL_R |= TIMER_CTL_TAEN;                  // turn-on timer
+}
+
+// Stops the background refresh once the current frame is sent, copies the back
+// buffer to the display, and returns to immediate drawing
+void stopGraphicsLcdRefresh()
+{
+    TIMER3_CTL_R &= ~TIMER_CTL_TAEN;
+    disableNvicInterrupt(INT_TIMER3A);
+    while (isSpi1DmaBusy());
+    backgroundRefresh = false;
+    deferred = false;
+    refreshGraphicsLcd();
+}
+
+// Publishes the back buffer as the next frame
+// The back buffer is copied rather than swapped with the front buffer, since drawing
+// continues on the current image and pixelMap is shared with the drawing modules
+// The 1 KB copy takes about 1000 cycles (25 us at 40 MHz), during which the refresh
+// interrupt is masked, so a frame is never sent half updated and may start up to
+// 25 us late
+// Without background refresh, the dirty spans are sent instead
+void swapGraphicsLcdBuffers()
+{
+    uint8_t page;
+    if (!backgroundRefresh)
+        flushGraphicsLcd();
+    else
+    {
+        disableNvicInterrupt(INT_TIMER3A);
+        memcpy(frontMap, pixelMap, sizeof(frontMap));
+        enableNvicInterrupt(INT_TIMER3A);
+        for (page = 0; page < 8; page++)             // spans are tracked by the refresh instead
+            dirtyCount[page] = 0;
+    }
+}
+
+// Sends the changed span of each page of the front buffer
+// The span is copied to panelMap first, so uDMA reads data that does not change
+// A frame is skipped if the previous one is still being sent
+void graphicsLcdRefreshIsr()
+{
+    uint8_t page, count = 0;
+    uint8_t first, last;
+    uint16_t base;
+    TIMER3_ICR_R = TIMER_ICR_TATOCINT;
+    if (isSpi1DmaBusy())
+        return;
+    for (page = 0; page < 8; page++)
+    {
+        base = page << 7;
+        first = 0;
+        while ((first < 128) && (frontMap[base + first] == panelMap[base + first]))
+            first++;
+        if (first == 128)
+            continue;
+        last = 127;
+        while (frontMap[base + last] == panelMap[base + last])
+            last--;
+        memcpy(&panelMap[base + first], &frontMap[base + first], last - first + 1);
+        pageCommands[page][0] = 0xB0 | page;
+        pageCommands[page][1] = 0x10 | (first >> 4);
+        pageCommands[page][2] = 0x00 | (first & 0x0F);
+        refreshSegments[count].data = pageCommands[page];
+        refreshSegments[count].size = 3;
+        refreshSegments[count++].before = selectGraphicsLcdCommand;
+        refreshSegments[count].data = &panelMap[base + first];
+        refreshSegments[count].size = last - first + 1;
+        refreshSegments[count++].before = selectGraphicsLcdData;
+    }
+    if (count)
+        writeSpi1DmaSegments(refreshSegments, count, 0);
 }
 
 void clearGraphicsLcd()
@@ -200,7 +579,11 @@ void clearGraphicsLcd()
     for (i = 0; i < 1024; i++)
         pixelMap[i] = 0;
     // copy to display
-    refreshGraphicsLcd();
+    if (deferred)
+        for (i = 0; i < 8; i++)
+            markGraphicsLcdDirty(i, 0, 128);
+    else
+        refreshGraphicsLcd();
 }
 
 void drawGraphicsLcdPixel(uint8_t x, uint8_t y, enum operation op)
@@ -231,10 +614,17 @@ void drawGraphicsLcdPixel(uint8_t x, uint8_t y, enum operation op)
     // write to pixel map
     pixelMap[index] = data;
 
+    if (deferred)
+    {
+        markGraphicsLcdDirty(page, x, 1);
+        return;
+    }
+
     // write to display
     setGraphicsLcdPage(page);
     setGraphicsLcdColumn(x);
     sendGraphicsLcdData(data);
+    panelMap[index] = data;
 }
 
 void drawGraphicsLcdRectangle(uint8_t xul, uint8_t yul, uint8_t dx, uint8_t dy, enum operation op)
@@ -242,7 +632,7 @@ void drawGraphicsLcdRectangle(uint8_t xul, uint8_t yul, uint8_t dx, uint8_t dy,
     uint8_t page, page_start, page_stop;
     uint8_t bit_index, bit_start, bit_stop;
     uint8_t mask, data;
-    uint16_t index;
+    uint16_t index, start;
     uint8_t x;
 
     // determine pages for rectangle
@@ -266,9 +656,7 @@ void drawGraphicsLcdRectangle(uint8_t xul, uint8_t yul, uint8_t dx, uint8_t dy,
             mask |= 1 << bit_index;
 
         // write page
-        setGraphicsLcdPage(page);
-        setGraphicsLcdColumn(xul);
-        index = (page << 7) | xul;
+        index = start = (page << 7) | xul;
         for (x = 0; x < dx; x++)
         {
             // read pixel map
@@ -282,8 +670,16 @@ void drawGraphicsLcdRectangle(uint8_t xul, uint8_t yul, uint8_t dx, uint8_t dy,
             }
             // write to pixel map
             pixelMap[index++] = data;
-            // write to display
-            sendGraphicsLcdData(data);
+        }
+        // write to display
+        if (deferred)
+            markGraphicsLcdDirty(page, xul, dx);
+        else
+        {
+            setGraphicsLcdPage(page);
+            setGraphicsLcdColumn(xul);
+            sendGraphicsLcdDataBlock(&pixelMap[start], dx);
+            memcpy(&panelMap[start], &pixelMap[start], dx);
         }
     }
 }
@@ -291,24 +687,33 @@ void drawGraphicsLcdRectangle(uint8_t xul, uint8_t yul, uint8_t dx, uint8_t dy,
 void setGraphicsLcdTextPosition(uint8_t x, uint8_t page)
 {
     txtIndex = (page << 7) + x;
+    if (deferred)
+        return;
     setGraphicsLcdPage(page);
     setGraphicsLcdColumn(x);
 }
 
 void putcGraphicsLcd(char c)
 {
-    uint8_t i, val;
+    uint8_t i;
     uint8_t uc;
+    uint16_t start = txtIndex;
     // convert to unsigned to access characters > 127
     uc = (uint8_t) c;
+    if ((uc < ' ') || (uc - ' ' >= CHARGEN_COUNT))
+        uc = '?';
+    if (txtIndex > 1024 - 6)           // no room left in the pixel map
+        return;
     for (i = 0; i < 5; i++)
+        pixelMap[txtIndex++] = charGen[uc-' '][i];
+    pixelMap[txtIndex++] = 0;
+    if (deferred)
+        markGraphicsLcdDirty(start >> 7, start & 127, 6);
+    else
     {
-        val = charGen[uc-' '][i];
-        pixelMap[txtIndex++] = val;
-        sendGraphicsLcdData(val);
+        sendGraphicsLcdDataBlock(&pixelMap[start], 6);
+        memcpy(&panelMap[start], &pixelMap[start], 6);
     }
-    pixelMap[txtIndex++] = 0;
-    sendGraphicsLcdData(0);
 }
 
 void putsGraphicsLcd(char str[])
@@ -318,13 +723,9 @@ void putsGraphicsLcd(char str[])
         putcGraphicsLcd(str[i++]);
 }
 
-void initGraphicsLcd()
+// Sends the power-up command sequence and clears the display
+void configureGraphicsLcd()
 {
-    // Initialize SPI1 interface
-    initSpi1(USE_SSI_FSS);
-    setSpi1BaudRate(1e6, 40e6);
-    setSpi1Mode(1, 1);
-
     // Enable clocks
     enablePort(PORTD);
 
@@ -348,3 +749,24 @@ void initGraphicsLcd()
     clearGraphicsLcd();           // clear display
     sendGraphicsLcdCommand(0xAF); // display on
 }
+
+void initGraphicsLcd()
+{
+    // Initialize SPI1 interface
+    initSpi1(USE_SSI_FSS);
+    setSpi1BaudRate(1e6, 40e6);
+    setSpi1Mode(1, 1);
+    lcdSpiDevice = SPI_INVALID_DEVICE;
+    configureGraphicsLcd();
+}
+
+// Drives the display as a device of the SPI bus manager
+// The device must be registered with mode 3, 8-bit frames, and a bit rate of up to
+// 20 MHz, e.g. addSpiDevice(1, PORTD, 1, 3, 1e6, 8) for ~CS on PD1
+// On SSI1, initSpi must be called with useRx false, since PD2 is used for A0
+void initGraphicsLcdSpiDevice(uint8_t device)
+{
+    lcdSpiDevice = device;
+    a0Level = 0xFF;
+    configureGraphicsLcd();
+}
@@ -0,0 +1,224 @@
+// Graphics LCD Host Backend
+// Jason Losh
+
+// Replaces the SPI1, SPI bus manager, GPIO, and NVIC functions used by graphics_lcd_gpio.c with an
+// emulation of the ST7565R page and column addressing, so drawing code can run
+// and be inspected on a PC without hardware
+// SPI frames are counted for measuring the traffic of each drawing routine
+// uDMA segment writes and bus manager transactions complete immediately
+// Background refresh (TIMER3A) is not emulated
+
+// Build: gcc -D'_delay_cycles(x)=' -o demo graphics_lcd_host_demo.c graphics_lcd_host.c
+//        graphics_lcd_gpio.c graphics_lcd_draw.c graphics_lcd_font.c -lm
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Linux PC
+// Target uC:       -
+// System Clock:    -
+
+// Hardware configuration:
+// Emulated ST7565R Graphics LCD Display (128x64)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>           // fopen, fprintf
+#include <stdint.h>          // C99 integer types
+#include <stdbool.h>         // bool
+#include <string.h>          // memset
+#include "gpio.h"
+#include "spi1.h"
+#include "spi.h"
+#include "graphics_lcd_host.h"
+
+// ST7565R display data RAM has 9 pages of 132 columns
+#define RAM_PAGES   9
+#define RAM_COLUMNS 132
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+uint8_t lcdRam[RAM_PAGES][RAM_COLUMNS];
+uint8_t lcdPage = 0;
+uint8_t lcdColumn = 0;
+bool lcdA0 = false;
+bool lcdInverse = false;
+GRAPHICS_LCD_HOST_COUNTS hostCounts;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Applies one SPI frame to the emulated controller
+void writeGraphicsLcdHostFrame(uint8_t byte)
+{
+    hostCounts.spiFrames++;
+    if (lcdA0)
+    {
+        hostCounts.dataFrames++;
+        if ((lcdPage < RAM_PAGES) && (lcdColumn < RAM_COLUMNS))
+            lcdRam[lcdPage][lcdColumn++] = byte;   // column address stops at the last column
+        return;
+    }
+    hostCounts.commandFrames++;
+    if ((byte & 0xF0) == 0xB0)
+        lcdPage = byte & 0x0F;
+    else if ((byte & 0xF0) == 0x10)
+        lcdColumn = (lcdColumn & 0x0F) | ((byte & 0x0F) << 4);
+    else if ((byte & 0xF0) == 0x00)
+        lcdColumn = (lcdColumn & 0xF0) | (byte & 0x0F);
+    else if ((byte & 0xFE) == 0xA6)
+        lcdInverse = byte & 1;
+    // other commands (bias, power, contrast, ...) do not change the image
+}
+
+void resetGraphicsLcdHostCounts()
+{
+    memset(&hostCounts, 0, sizeof(hostCounts));
+}
+
+void getGraphicsLcdHostCounts(GRAPHICS_LCD_HOST_COUNTS* counts)
+{
+    *counts = hostCounts;
+}
+
+// Returns the pixel shown at (x, y), including the inverse display setting
+bool getGraphicsLcdHostPixel(uint8_t x, uint8_t y)
+{
+    return (((lcdRam[y >> 3][x] >> (y & 7)) & 1) != 0) != lcdInverse;
+}
+
+// Writes the display as a binary PBM image (1 = black)
+bool writeGraphicsLcdHostPbm(const char filename[])
+{
+    uint8_t x, y, byte = 0;
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL)
+        return false;
+    fprintf(file, "P4\n128 64\n");
+    for (y = 0; y < 64; y++)
+    {
+        for (x = 0; x < 128; x++)
+        {
+            byte = (byte << 1) | getGraphicsLcdHostPixel(x, y);
+            if ((x & 7) == 7)
+                fputc(byte, file);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+// GPIO: only the A0 pin (PD2) of the display is emulated
+void enablePort(PORT port)
+{
+}
+
+void selectPinPushPullOutput(PORT port, uint8_t pin)
+{
+}
+
+void setPinValue(PORT port, uint8_t pin, bool value)
+{
+    if ((port == PORTD) && (pin == 2))
+    {
+        hostCounts.a0Writes++;
+        lcdA0 = value;
+    }
+}
+
+// NVIC
+void enableNvicInterrupt(uint8_t vectorNumber)
+{
+}
+
+void disableNvicInterrupt(uint8_t vectorNumber)
+{
+}
+
+// SPI1
+void initSpi1(uint32_t pinMask)
+{
+    memset(lcdRam, 0, sizeof(lcdRam));
+    lcdPage = lcdColumn = 0;
+    lcdInverse = false;
+    resetGraphicsLcdHostCounts();
+}
+
+void setSpi1BaudRate(uint32_t baudRate, uint32_t fcyc)
+{
+}
+
+void setSpi1Mode(uint8_t polarity, uint8_t phase)
+{
+}
+
+void writeSpi1Data(uint32_t data)
+{
+    writeGraphicsLcdHostFrame(data);
+}
+
+void putSpi1Data(uint32_t data)
+{
+    writeGraphicsLcdHostFrame(data);
+}
+
+void waitSpi1Idle()
+{
+}
+
+void writeSpi1Block(const uint8_t data[], uint16_t size)
+{
+    uint16_t i;
+    for (i = 0; i < size; i++)
+        writeGraphicsLcdHostFrame(data[i]);
+}
+
+bool writeSpi1DmaSegments(const SPI1_SEGMENT segments[], uint8_t count, SPI1_CALLBACK callback)
+{
+    uint8_t i;
+    for (i = 0; i < count; i++)
+    {
+        if (segments[i].before)
+            segments[i].before();
+        writeSpi1Block(segments[i].data, segments[i].size);
+    }
+    if (callback)
+        callback();
+    return true;
+}
+
+bool isSpi1DmaBusy()
+{
+    return false;
+}
+
+// SPI bus manager (the display is the only device)
+void initSpi(uint8_t ssi, uint32_t fcyc, bool useRx)
+{
+    initSpi1(0);
+}
+
+uint8_t addSpiDevice(uint8_t ssi, PORT csPort, uint8_t csPin, uint8_t mode, uint32_t bitRate, uint8_t frameSize)
+{
+    return 0;
+}
+
+bool queueSpiTransaction(SPI_TRANSACTION* transaction)
+{
+    const uint8_t* data = transaction->txData;
+    uint16_t i;
+    if (transaction->before)
+        transaction->before();
+    for (i = 0; i < transaction->size; i++)
+        writeGraphicsLcdHostFrame(data ? data[i] : 0xFF);
+    transaction->done = true;
+    if (transaction->callback)
+        transaction->callback();
+    return true;
+}
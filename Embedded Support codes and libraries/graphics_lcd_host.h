@@ -0,0 +1,42 @@
+// Graphics LCD Host Backend
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Linux PC
+// Target uC:       -
+// System Clock:    -
+
+// Hardware configuration:
+// Emulated ST7565R Graphics LCD Display (128x64)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef GRAPHICS_LCD_HOST_H_
+#define GRAPHICS_LCD_HOST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct _GRAPHICS_LCD_HOST_COUNTS
+{
+    uint32_t spiFrames;                // all frames written to SPI1
+    uint32_t commandFrames;            // frames sent with A0 low
+    uint32_t dataFrames;               // frames sent with A0 high
+    uint32_t a0Writes;                 // writes to the A0 pin
+} GRAPHICS_LCD_HOST_COUNTS;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void resetGraphicsLcdHostCounts();
+void getGraphicsLcdHostCounts(GRAPHICS_LCD_HOST_COUNTS* counts);
+bool getGraphicsLcdHostPixel(uint8_t x, uint8_t y);
+bool writeGraphicsLcdHostPbm(const char filename[]);
+
+#endif
@@ -0,0 +1,88 @@
+// Graphics LCD Host Demo
+// Jason Losh
+
+// Draws a plot like pid.c drawPlot() on the emulated display in immediate
+// and deferred modes, prints the SPI frames used by each, and saves PBM images
+// Build: see graphics_lcd_host.c
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Linux PC
+// Target uC:       -
+// System Clock:    -
+
+// Hardware configuration:
+// Emulated ST7565R Graphics LCD Display (128x64)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>          // EXIT_ codes
+#include <stdio.h>           // printf
+#include <stdint.h>          // C99 integer types
+#include <stdbool.h>         // bool
+#include <math.h>            // sin
+#include "graphics_lcd.h"
+#include "graphics_lcd_draw.h"
+#include "graphics_lcd_font.h"
+#include "graphics_lcd_host.h"
+
+#define CAPTURE_SIZE 100
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void drawDemoPlot(uint8_t phase)
+{
+    uint8_t x, y;
+    drawGraphicsLcdRectangle(0, 0, 104, 64, CLEAR);
+    for (x = 4; x < CAPTURE_SIZE; x += 8)
+        drawGraphicsLcdHLine(x, 16, 4, SET);
+    setGraphicsLcdTextPosition(90, 7);
+    putcGraphicsLcd('y');
+    for (x = 0; x < CAPTURE_SIZE; x++)
+    {
+        y = 32 - 28 * sin((x + phase) * 0.12);
+        drawGraphicsLcdPixel(x, y, SET);
+    }
+}
+
+// Prints and resets the frame counts of a drawing step
+void report(const char name[])
+{
+    GRAPHICS_LCD_HOST_COUNTS counts;
+    getGraphicsLcdHostCounts(&counts);
+    printf("%-24s %6u frames (%u command, %u data), %u A0 writes\n", name,
+           counts.spiFrames, counts.commandFrames, counts.dataFrames, counts.a0Writes);
+    resetGraphicsLcdHostCounts();
+}
+
+int main(void)
+{
+    initGraphicsLcd();
+    report("init");
+
+    drawDemoPlot(0);
+    report("plot (immediate)");
+
+    setGraphicsLcdDeferred(true);
+    drawDemoPlot(10);
+    flushGraphicsLcd();
+    setGraphicsLcdDeferred(false);
+    report("plot (deferred)");
+    writeGraphicsLcdHostPbm("plot.pbm");
+
+    clearGraphicsLcd();
+    drawGraphicsLcdCircle(32, 32, 28, SET);
+    drawGraphicsLcdLine(4, 60, 60, 4, SET);
+    drawGraphicsLcdText(70, 8, "23.5", &font5x7, 2, SET);
+    drawGraphicsLcdText(70, 30, "Temp \x82""C", &font5x7, 1, SET);
+    report("shapes and text");
+    writeGraphicsLcdHostPbm("shapes.pbm");
+
+    return EXIT_SUCCESS;
+}
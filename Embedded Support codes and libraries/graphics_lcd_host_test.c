@@ -0,0 +1,381 @@
+// Graphics LCD Host Test
+// Jason Losh
+
+// Draws spans, lines, circles, polygon fills, and bitmap blits with the SET,
+// CLEAR, and INVERT operators over a background on the emulated display and
+// checks each image against:
+//   a golden PBM in graphics_lcd_golden/
+//   the image expected from the operator and the SET shape on a clear display
+//   an independent per-pixel model (spans, polygon fills, and bitmaps)
+//   the same drawing in deferred mode, which must not use more SPI frames
+// The SPI frames used by each drawing are printed as a benchmark (8 us per
+// frame at the 1 MHz bit rate of initGraphicsLcd())
+// Exits with EXIT_SUCCESS if all checks pass; failing images are saved as
+// <name>_actual.pbm in the current directory
+// Run from this directory; with -u, the golden images are rewritten instead
+
+// Build: gcc -D'_delay_cycles(x)=' -o test graphics_lcd_host_test.c graphics_lcd_host.c
+//        graphics_lcd_gpio.c graphics_lcd_draw.c graphics_lcd_font.c
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Linux PC
+// Target uC:       -
+// System Clock:    -
+
+// Hardware configuration:
+// Emulated ST7565R Graphics LCD Display (128x64)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>          // EXIT_ codes
+#include <stdio.h>           // printf, fopen
+#include <stdint.h>          // C99 integer types
+#include <stdbool.h>         // bool
+#include <string.h>          // memcmp, strcmp
+#include "graphics_lcd.h"
+#include "graphics_lcd_draw.h"
+#include "graphics_lcd_host.h"
+
+#define WIDTH  GRAPHICS_LCD_WIDTH
+#define HEIGHT GRAPHICS_LCD_HEIGHT
+#define PBM_HEADER "P4\n128 64\n"
+#define PBM_SIZE (sizeof(PBM_HEADER) - 1 + WIDTH * HEIGHT / 8)
+#define GOLDEN_PATH "graphics_lcd_golden/"
+
+typedef bool IMAGE[HEIGHT][WIDTH];
+
+typedef struct _SHAPE
+{
+    const char* name;
+    void (*draw)(enum operation op);
+    void (*model)(IMAGE image);        // sets the pixels of the shape, or 0
+} SHAPE;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const char* opNames[] = {"clear", "set", "invert"};
+
+// Primitives of a shape do not overlap, so INVERT toggles each pixel once
+
+const GRAPHICS_LCD_POINT triangle[] = {{4, 4}, {40, 12}, {14, 40}};
+const GRAPHICS_LCD_POINT star[] = {{80, 2}, {92, 38}, {62, 16}, {98, 16}, {68, 38}};
+const GRAPHICS_LCD_POINT quad[] = {{100, 30}, {140, 44}, {120, 80}, {96, 60}};
+const GRAPHICS_LCD_POINT concave[] = {{4, 46}, {60, 46}, {60, 62}, {40, 54}, {4, 62}};
+
+// 12x10 arrow, page organized
+#define ARROW_WIDTH  12
+#define ARROW_HEIGHT 10
+const uint8_t arrow[] =
+{
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFF, 0x7E, 0x3C, 0x18, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03
+};
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void drawSpans(enum operation op)
+{
+    uint8_t i;
+    for (i = 0; i < 8; i++)
+        drawGraphicsLcdHLine(4 + i, 2 + 3 * i, 40 - 2 * i, op);
+    drawGraphicsLcdHLine(-6, 30, 20, op);              // clipped left
+    drawGraphicsLcdHLine(100, 63, 40, op);             // clipped right, last row
+    drawGraphicsLcdHLine(10, 34, 1, op);
+    for (i = 0; i < 8; i++)
+        drawGraphicsLcdVLine(50 + 3 * i, 1 + i, 6 + 7 * i, op);
+    drawGraphicsLcdVLine(90, -5, 12, op);              // clipped top
+    drawGraphicsLcdVLine(95, 40, 40, op);              // clipped bottom
+    drawGraphicsLcdVLine(100, 8, 8, op);               // one full page
+    drawGraphicsLcdVLine(127, 20, 1, op);
+}
+
+void modelSpans(IMAGE image)
+{
+    int16_t i, x, y;
+    for (i = 0; i < 8; i++)
+        for (x = 4 + i; x < 44 - i; x++)
+            image[2 + 3 * i][x] = true;
+    for (x = 0; x < 14; x++)
+        image[30][x] = true;
+    for (x = 100; x < WIDTH; x++)
+        image[63][x] = true;
+    image[34][10] = true;
+    for (i = 0; i < 8; i++)
+        for (y = 1 + i; y < 7 + 8 * i; y++)
+            image[y][50 + 3 * i] = true;
+    for (y = 0; y < 7; y++)
+        image[y][90] = true;
+    for (y = 40; y < HEIGHT; y++)
+        image[y][95] = true;
+    for (y = 8; y < 16; y++)
+        image[y][100] = true;
+    image[20][127] = true;
+}
+
+// Line directions, one per octant
+const GRAPHICS_LCD_POINT octants[] =
+{
+    {13, 5}, {5, 14}, {-5, 14}, {-13, 5}, {-13, -5}, {-5, -14}, {5, -14}, {13, -5}
+};
+
+void drawLines(enum operation op)
+{
+    uint8_t i;
+    int16_t x, y;
+    // one line per octant, each in its own 16x31 cell
+    for (i = 0; i < 8; i++)
+    {
+        x = 16 * i + ((octants[i].x > 0) ? 1 : 14);
+        y = (octants[i].y > 0) ? 1 : 29;
+        drawGraphicsLcdLine(x, y, x + octants[i].x, y + octants[i].y, op);
+    }
+    drawGraphicsLcdLine(30, 34, 50, 54, op);           // diagonal
+    drawGraphicsLcdLine(54, 34, 80, 34, op);           // horizontal
+    drawGraphicsLcdLine(84, 50, 84, 36, op);           // vertical
+    drawGraphicsLcdLine(-20, 40, 40, 70, op);          // clipped at both ends
+    drawGraphicsLcdLine(60, 62, 150, 36, op);          // clipped right
+    drawGraphicsLcdLine(100, 38, 101, 39, op);
+    drawGraphicsLcdLine(110, 40, 110, 40, op);         // single pixel
+}
+
+void drawCircles(enum operation op)
+{
+    uint8_t r;
+    drawGraphicsLcdCircle(4, 4, 0, op);
+    for (r = 1; r <= 28; r += 3)
+        drawGraphicsLcdCircle(32, 32, r, op);
+    drawGraphicsLcdCircle(84, 20, 14, op);
+    drawGraphicsLcdCircle(84, 20, 5, op);
+    drawGraphicsLcdCircle(120, 58, 18, op);            // clipped right and bottom
+    drawGraphicsLcdCircle(80, 75, 16, op);             // center off screen
+}
+
+void drawPolygons(enum operation op)
+{
+    fillGraphicsLcdPolygon(triangle, 3, op);
+    fillGraphicsLcdPolygon(star, 5, op);               // even-odd leaves the center open
+    fillGraphicsLcdPolygon(quad, 4, op);               // clipped right and bottom
+    fillGraphicsLcdPolygon(concave, 5, op);
+}
+
+// Pixel centers inside the polygon by the even-odd rule, with a center on an
+// edge counted as inside when the polygon is to its right
+bool isInsidePolygon(const GRAPHICS_LCD_POINT points[], uint8_t count, int16_t x, int16_t y)
+{
+    uint8_t i, j;
+    int32_t n, d;
+    bool inside = false;
+    for (i = 0, j = count - 1; i < count; j = i++)
+    {
+        const GRAPHICS_LCD_POINT *a = &points[i], *b = &points[j];
+        if ((a->y <= y) == (b->y <= y))
+            continue;
+        // crossing at a.x + n / d, left of or at x + 0.5
+        n = (int32_t)(2 * (y - a->y) + 1) * (b->x - a->x);
+        d = 2 * (b->y - a->y);
+        if ((d > 0) ? (2 * n <= (2 * (x - a->x) + 1) * d) : (2 * n >= (2 * (x - a->x) + 1) * d))
+            inside = !inside;
+    }
+    return inside;
+}
+
+void modelPolygons(IMAGE image)
+{
+    int16_t x, y;
+    for (y = 0; y < HEIGHT; y++)
+        for (x = 0; x < WIDTH; x++)
+            image[y][x] = isInsidePolygon(triangle, 3, x, y) || isInsidePolygon(star, 5, x, y)
+                          || isInsidePolygon(quad, 4, x, y) || isInsidePolygon(concave, 5, x, y);
+}
+
+// Blits at all 8 bit offsets in a page, and clipped on each side
+const GRAPHICS_LCD_POINT blits[] =
+{
+    {2, 0}, {16, 9}, {30, 18}, {44, 27}, {58, 36}, {72, 45}, {86, 54}, {100, 3},
+    {-5, 30}, {121, 20}, {40, -6}, {110, 58}
+};
+
+void drawBitmaps(enum operation op)
+{
+    uint8_t i;
+    for (i = 0; i < sizeof(blits) / sizeof(blits[0]); i++)
+        drawGraphicsLcdBitmap(blits[i].x, blits[i].y, arrow, ARROW_WIDTH, ARROW_HEIGHT, op);
+}
+
+void modelBitmaps(IMAGE image)
+{
+    uint8_t i;
+    int16_t row, column, x, y;
+    for (i = 0; i < sizeof(blits) / sizeof(blits[0]); i++)
+        for (row = 0; row < ARROW_HEIGHT; row++)
+            for (column = 0; column < ARROW_WIDTH; column++)
+            {
+                x = blits[i].x + column;
+                y = blits[i].y + row;
+                if ((x >= 0) && (x < WIDTH) && (y >= 0) && (y < HEIGHT)
+                    && ((arrow[(row >> 3) * ARROW_WIDTH + column] >> (row & 7)) & 1))
+                    image[y][x] = true;
+            }
+}
+
+const SHAPE shapes[] =
+{
+    {"spans", drawSpans, modelSpans},
+    {"lines", drawLines, 0},
+    {"circles", drawCircles, 0},
+    {"polygons", drawPolygons, modelPolygons},
+    {"bitmaps", drawBitmaps, modelBitmaps}
+};
+
+// Background with set and clear areas, so all operators change the image
+void drawBackground()
+{
+    clearGraphicsLcd();
+    drawGraphicsLcdRectangle(32, 0, 64, 64, SET);
+    drawGraphicsLcdRectangle(44, 20, 40, 24, CLEAR);
+}
+
+void readImage(IMAGE image)
+{
+    uint8_t x, y;
+    for (y = 0; y < HEIGHT; y++)
+        for (x = 0; x < WIDTH; x++)
+            image[y][x] = getGraphicsLcdHostPixel(x, y);
+}
+
+// Returns the SPI frames used to draw the shape over the background
+uint32_t drawShape(const SHAPE* shape, enum operation op, bool deferred, IMAGE image)
+{
+    GRAPHICS_LCD_HOST_COUNTS counts;
+    drawBackground();
+    resetGraphicsLcdHostCounts();
+    setGraphicsLcdDeferred(deferred);
+    shape->draw(op);
+    flushGraphicsLcd();
+    setGraphicsLcdDeferred(false);
+    getGraphicsLcdHostCounts(&counts);
+    readImage(image);
+    return counts.spiFrames;
+}
+
+bool isEqualImage(IMAGE a, IMAGE b)
+{
+    return memcmp(a, b, sizeof(IMAGE)) == 0;
+}
+
+// Builds the PBM file of the display in memory
+void makePbm(uint8_t pbm[])
+{
+    uint8_t x, y, byte = 0;
+    uint16_t i = sizeof(PBM_HEADER) - 1;
+    memcpy(pbm, PBM_HEADER, i);
+    for (y = 0; y < HEIGHT; y++)
+        for (x = 0; x < WIDTH; x++)
+        {
+            byte = (byte << 1) | getGraphicsLcdHostPixel(x, y);
+            if ((x & 7) == 7)
+                pbm[i++] = byte;
+        }
+}
+
+// Returns true if the display matches the golden image, or writes it if update is true
+bool checkGolden(const char name[], bool update)
+{
+    char filename[80];
+    uint8_t pbm[PBM_SIZE], golden[PBM_SIZE + 1];
+    FILE* file;
+    size_t size = 0;
+    snprintf(filename, sizeof(filename), GOLDEN_PATH "%s.pbm", name);
+    if (update)
+        return writeGraphicsLcdHostPbm(filename);
+    makePbm(pbm);
+    file = fopen(filename, "rb");
+    if (file != NULL)
+    {
+        size = fread(golden, 1, sizeof(golden), file);
+        fclose(file);
+    }
+    else
+        printf("  missing %s\n", filename);
+    return (size == PBM_SIZE) && (memcmp(pbm, golden, PBM_SIZE) == 0);
+}
+
+int main(int argc, char* argv[])
+{
+    static IMAGE background, mask, model, expected, image, deferredImage;
+    const SHAPE* shape;
+    bool update = (argc > 1) && (strcmp(argv[1], "-u") == 0);
+    bool pass, failed = false;
+    char name[40];
+    uint32_t frames, deferredFrames, totalFrames = 0, totalDeferredFrames = 0;
+    uint8_t i, x, y;
+    enum operation op;
+
+    initGraphicsLcd();
+    drawBackground();
+    readImage(background);
+
+    printf("%-18s %8s %8s %10s\n", "drawing", "frames", "deferred", "us @ 1MHz");
+    for (i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+    {
+        shape = &shapes[i];
+
+        // the shape is what SET draws on a clear display
+        clearGraphicsLcd();
+        shape->draw(SET);
+        readImage(mask);
+        if (shape->model)
+        {
+            memset(model, 0, sizeof(model));
+            shape->model(model);
+            if (!isEqualImage(mask, model))
+            {
+                printf("%s: differs from the pixel model\n", shape->name);
+                snprintf(name, sizeof(name), "%s_model_actual.pbm", shape->name);
+                writeGraphicsLcdHostPbm(name);
+                failed = true;
+            }
+        }
+
+        for (op = CLEAR; op <= INVERT; op++)
+        {
+            snprintf(name, sizeof(name), "%s_%s", shape->name, opNames[op]);
+            frames = drawShape(shape, op, false, image);
+            pass = checkGolden(name, update);
+            deferredFrames = drawShape(shape, op, true, deferredImage);
+            for (y = 0; y < HEIGHT; y++)
+                for (x = 0; x < WIDTH; x++)
+                    switch (op)
+                    {
+                        case CLEAR:  expected[y][x] = background[y][x] && !mask[y][x]; break;
+                        case SET:    expected[y][x] = background[y][x] || mask[y][x]; break;
+                        case INVERT: expected[y][x] = background[y][x] != mask[y][x]; break;
+                    }
+            pass = pass && isEqualImage(image, expected) && isEqualImage(deferredImage, expected)
+                   && deferredFrames <= frames;
+            printf("%-18s %8u %8u %10u %s\n", name, frames, deferredFrames, frames * 8,
+                   update ? "updated" : (pass ? "pass" : "FAIL"));
+            if (!pass && !update)
+            {
+                drawShape(shape, op, false, image);
+                snprintf(name, sizeof(name), "%s_%s_actual.pbm", shape->name, opNames[op]);
+                writeGraphicsLcdHostPbm(name);
+                failed = true;
+            }
+            totalFrames += frames;
+            totalDeferredFrames += deferredFrames;
+        }
+    }
+    printf("%-18s %8u %8u %10u\n", "total", totalFrames, totalDeferredFrames, totalFrames * 8);
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
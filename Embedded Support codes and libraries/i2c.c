@@ -0,0 +1,615 @@
+// I2C Library
+// Jason Losh
+
+// Hook in i2cNIsr to the I2CN IVT entry of each I2C module used
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// I2C Interfaces (SCL, SDA), each with 2kohm pullups on SDA and SCL:
+//   I2C0 on PB2, PB3
+//   I2C1 on PA6, PA7
+//   I2C2 on PE4, PE5
+//   I2C3 on PD0, PD1
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "tm4c123gh6pm.h"
+#include "i2c.h"
+#include "gpio.h"
+#include "nvic.h"
+#include "cycles.h"
+
+// Register access relative to the module base address
+#define I2C_MSA(b)      (*((volatile uint32_t *)((b) + 0x000)))
+#define I2C_MCS(b)      (*((volatile uint32_t *)((b) + 0x004)))
+#define I2C_MDR(b)      (*((volatile uint32_t *)((b) + 0x008)))
+#define I2C_MTPR(b)     (*((volatile uint32_t *)((b) + 0x00C)))
+#define I2C_MIMR(b)     (*((volatile uint32_t *)((b) + 0x010)))
+#define I2C_MICR(b)     (*((volatile uint32_t *)((b) + 0x01C)))
+#define I2C_MCR(b)      (*((volatile uint32_t *)((b) + 0x020)))
+#define I2C_MBMON(b)    (*((volatile uint32_t *)((b) + 0x02C)))
+
+// Transaction phases
+#define PHASE_WRITE 0
+#define PHASE_READ  1
+#define PHASE_STOP  2                  // releasing the bus after a nack
+
+// Fixed hardware description of each module
+typedef struct _I2C_DESCRIPTOR
+{
+    uint32_t base;
+    uint32_t clockMask;
+    PORT port;
+    uint8_t sclPin;
+    uint8_t sdaPin;
+    uint8_t pinFunction;
+    uint8_t vector;
+} I2C_DESCRIPTOR;
+
+// Run-time state of each module
+typedef struct _I2C_STATE
+{
+    // Queue of transactions (written by the application, read by the isr)
+    I2C_TRANSACTION* queue[I2C_QUEUE_SIZE];
+    uint8_t queueReadIndex;
+    volatile uint8_t queueWriteIndex;
+    I2C_TRANSACTION* volatile active;
+    // Position within the active transaction
+    uint8_t phase;
+    uint8_t index;
+    uint8_t writeCount;
+    uint8_t readCount;
+    bool stopSent;
+    I2C_STATUS nackStatus;             // reported once the stop after a nack is sent
+    uint8_t retries;
+    // Bounded latency (cycles since the last command issued to the active transaction)
+    uint32_t timeout;
+    uint32_t progressTime;
+    I2C_STATS stats;
+    I2C_STATUS lastStatus;
+} I2C_STATE;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const I2C_DESCRIPTOR i2cDescriptor[I2C_COUNT] =
+{
+    {0x40020000, SYSCTL_RCGCI2C_R0, PORTB, 2, 3, 3, INT_I2C0},
+    {0x40021000, SYSCTL_RCGCI2C_R1, PORTA, 6, 7, 3, INT_I2C1},
+    {0x40022000, SYSCTL_RCGCI2C_R2, PORTE, 4, 5, 3, INT_I2C2},
+    {0x40023000, SYSCTL_RCGCI2C_R3, PORTD, 0, 1, 3, INT_I2C3}
+};
+
+I2C_STATE i2cState[I2C_COUNT];
+uint8_t i2cDummy;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Initialize I2C module as a 100kbps master (assumes 40MHz, see setI2cBitRate)
+void initI2c(uint8_t i2c)
+{
+    const I2C_DESCRIPTOR* d = &i2cDescriptor[i2c];
+    I2C_STATE* s = &i2cState[i2c];
+
+    // Enable clocks
+    SYSCTL_RCGCI2C_R |= d->clockMask;
+    _delay_cycles(3);
+    enablePort(d->port);
+
+    // Configure I2C pins
+    selectPinPushPullOutput(d->port, d->sclPin);
+    setPinAuxFunction(d->port, d->sclPin, d->pinFunction);
+    selectPinOpenDrainOutput(d->port, d->sdaPin);
+    setPinAuxFunction(d->port, d->sdaPin, d->pinFunction);
+
+    // Configure I2C peripheral
+    I2C_MCR(d->base) = 0;                               // disable to program
+    I2C_MTPR(d->base) = 19;                             // (40MHz/2) / (6+4) / (19+1) = 100kbps
+    I2C_MCR(d->base) = I2C_MCR_MFE;                     // master
+    I2C_MCS(d->base) = I2C_MCS_STOP;
+
+    // Empty queue
+    s->queueReadIndex = s->queueWriteIndex = 0;
+    s->active = 0;
+    s->lastStatus = I2C_OK;
+    s->timeout = I2C_DEFAULT_TIMEOUT;
+    clearI2cStats(i2c);
+
+    // Latency and timeouts are measured in cycles
+    initCycleCounter();
+
+    // Free the bus if a device was left mid-transfer by a reset
+    if (!(I2C_MBMON(d->base) & I2C_MBMON_SDA))
+        recoverI2cBus(i2c);
+
+    // Interrupt on completion of each byte
+    I2C_MICR(d->base) = I2C_MICR_IC;
+    I2C_MIMR(d->base) = I2C_MIMR_IM;
+    enableNvicInterrupt(d->vector);
+}
+
+// Set bit rate as function of instruction cycle frequency
+// SCL period = 2 * (1 + TPR) * (6 + 4) cycles, so 100k, 400k and 1Mbps are exact at 40MHz
+// Returns the programmed rate, or 0 if the rate is out of range or the bus is not idle
+uint32_t setI2cBitRate(uint8_t i2c, uint32_t bitRate, uint32_t fcyc)
+{
+    uint32_t base = i2cDescriptor[i2c].base;
+    uint32_t tpr;
+    if (bitRate == 0 || bitRate > I2C_MAX_BIT_RATE)
+        return 0;
+    // Round up so the bus is never clocked faster than requested
+    tpr = (fcyc + 20 * bitRate - 1) / (20 * bitRate) - 1;
+    if (tpr < 1)
+        tpr = 1;
+    if (tpr > I2C_MTPR_TPR_M)
+        return 0;
+    // Both lines must be released by the pullups before changing speed
+    while (isI2cBusy(i2c))
+        checkI2cTimeout(i2c);
+    if ((I2C_MBMON(base) & (I2C_MBMON_SCL | I2C_MBMON_SDA)) != (I2C_MBMON_SCL | I2C_MBMON_SDA))
+        return 0;
+    I2C_MTPR(base) = tpr;
+    return fcyc / (20 * (tpr + 1));
+}
+
+// Sets the longest time without bus progress before a transaction is aborted
+// Must cover the longest clock stretch of any device on the bus
+void setI2cTimeout(uint8_t i2c, uint32_t cycles)
+{
+    i2cState[i2c].timeout = cycles;
+}
+
+// Clears a transaction and sets its address and register
+void prepareI2cTransaction(I2C_TRANSACTION* transaction, uint8_t add, uint8_t flags, uint8_t reg)
+{
+    memset(transaction, 0, sizeof(I2C_TRANSACTION));
+    transaction->address = add;
+    transaction->flags = flags;
+    transaction->reg = reg;
+}
+
+// Times an address-only read of add and returns the effective bit rate
+// Slow rise times (weak pullups) and clock stretching both show up as a lower rate
+// The address does not need to ack, but a device that holds SCL should be used
+// to check that it can keep up
+uint32_t measureI2cBitRate(uint8_t i2c, uint8_t add, uint32_t fcyc)
+{
+    I2C_TRANSACTION transaction;
+    uint32_t bitTimes;
+    prepareI2cTransaction(&transaction, add, 0, 0);
+    transaction.readData = &i2cDummy;
+    transaction.readSize = 1;
+    runI2cTransaction(i2c, &transaction);
+    // Start, 8 address bits, nack and stop take about 10 bit times
+    // When the address is acked, the byte read and its nack add 9 more
+    if (transaction.latency == 0)
+        return 0;
+    bitTimes = (transaction.status == I2C_OK) ? 19 : 10;
+    return (uint32_t)(((uint64_t)fcyc * bitTimes) / transaction.latency);
+}
+
+// Byte i of the write phase (reg is byte 0 when I2C_REGISTER is set)
+uint8_t getI2cWriteByte(I2C_TRANSACTION* transaction, uint8_t i)
+{
+    if (transaction->flags & I2C_REGISTER)
+    {
+        if (i == 0)
+            return transaction->reg;
+        i--;
+    }
+    return transaction->writeData[i];
+}
+
+// Issues a command, remembering whether it ends the transfer and when it was sent
+void commandI2c(uint8_t i2c, uint32_t command)
+{
+    I2C_STATE* s = &i2cState[i2c];
+    s->stopSent = (command & I2C_MCS_STOP) != 0;
+    s->progressTime = getCycleCount();
+    I2C_MCS(i2cDescriptor[i2c].base) = command;
+}
+
+// Spins for a number of cycles
+void waitI2cCycles(uint32_t cycles)
+{
+    uint32_t start = getCycleCount();
+    while ((getCycleCount() - start) < cycles);
+}
+
+// Frees a bus held by a slave that lost track of the clock
+// SCL is driven as a gpio for up to 9 clocks until the slave releases SDA,
+// then a stop condition is generated and the pins are returned to the module
+// The data bits are left at 0, so a line is pulled low by making its pin an
+// output and released (and sensed) by making it an input
+I2C_STATUS recoverI2cBus(uint8_t i2c)
+{
+    const I2C_DESCRIPTOR* d = &i2cDescriptor[i2c];
+    uint32_t halfPeriod = 10 * ((I2C_MTPR(d->base) & I2C_MTPR_TPR_M) + 1);
+    uint8_t i;
+    bool free;
+
+    I2C_MCR(d->base) = 0;
+    i2cState[i2c].stats.recoveryCount++;
+
+    // Take the pins as gpio inputs with both lines released
+    setPinValue(d->port, d->sclPin, 0);
+    setPinValue(d->port, d->sdaPin, 0);
+    selectPinDigitalInput(d->port, d->sclPin);
+    selectPinDigitalInput(d->port, d->sdaPin);
+    setPinAuxFunction(d->port, d->sclPin, 0);
+    setPinAuxFunction(d->port, d->sdaPin, 0);
+    waitI2cCycles(halfPeriod);
+
+    // Clock until the slave finishes its byte and releases SDA
+    for (i = 0; i < 9 && !getPinValue(d->port, d->sdaPin); i++)
+    {
+        selectPinOpenDrainOutput(d->port, d->sclPin);
+        waitI2cCycles(halfPeriod);
+        selectPinDigitalInput(d->port, d->sclPin);
+        waitI2cCycles(halfPeriod);
+    }
+
+    // Stop condition (SDA rises while SCL is high)
+    selectPinOpenDrainOutput(d->port, d->sclPin);
+    waitI2cCycles(halfPeriod);
+    selectPinOpenDrainOutput(d->port, d->sdaPin);
+    waitI2cCycles(halfPeriod);
+    selectPinDigitalInput(d->port, d->sclPin);
+    waitI2cCycles(halfPeriod);
+    selectPinDigitalInput(d->port, d->sdaPin);
+    waitI2cCycles(halfPeriod);
+    free = getPinValue(d->port, d->sdaPin) && getPinValue(d->port, d->sclPin);
+
+    // Return the pins to the module
+    selectPinPushPullOutput(d->port, d->sclPin);
+    selectPinOpenDrainOutput(d->port, d->sdaPin);
+    setPinAuxFunction(d->port, d->sclPin, d->pinFunction);
+    setPinAuxFunction(d->port, d->sdaPin, d->pinFunction);
+    I2C_MCR(d->base) = I2C_MCR_MFE;
+    I2C_MICR(d->base) = I2C_MICR_IC;
+    return free ? I2C_OK : I2C_BUS_STUCK;
+}
+
+void startI2cRead(uint8_t i2c, I2C_TRANSACTION* transaction)
+{
+    I2C_STATE* s = &i2cState[i2c];
+    // An address-only transaction reads one byte into a dummy
+    s->phase = PHASE_READ;
+    s->index = 0;
+    s->readCount = transaction->readSize > 0 ? transaction->readSize : 1;
+    I2C_MSA(i2cDescriptor[i2c].base) = (transaction->address << 1) | 1; // add:r/~w=1
+    commandI2c(i2c, I2C_MCS_START | I2C_MCS_RUN | (s->readCount > 1 ? I2C_MCS_ACK : I2C_MCS_STOP));
+}
+
+// Starts (or restarts after a lost arbitration) the active transaction
+void beginI2cTransaction(uint8_t i2c, I2C_TRANSACTION* transaction)
+{
+    uint32_t base = i2cDescriptor[i2c].base;
+    I2C_STATE* s = &i2cState[i2c];
+    s->writeCount = transaction->writeSize + ((transaction->flags & I2C_REGISTER) ? 1 : 0);
+    if (s->writeCount > 0)
+    {
+        s->phase = PHASE_WRITE;
+        s->index = 0;
+        I2C_MSA(base) = transaction->address << 1; // add:r/~w=0
+        I2C_MDR(base) = getI2cWriteByte(transaction, 0);
+        commandI2c(i2c, I2C_MCS_START | I2C_MCS_RUN
+                        | ((s->writeCount == 1 && transaction->readSize == 0) ? I2C_MCS_STOP : 0));
+    }
+    else
+        startI2cRead(i2c, transaction);
+}
+
+// Starts the transaction at the head of the queue, if any
+void startI2cTransaction(uint8_t i2c)
+{
+    I2C_STATE* s = &i2cState[i2c];
+    I2C_TRANSACTION* transaction;
+    if (s->queueReadIndex == s->queueWriteIndex)
+    {
+        s->active = 0;
+        return;
+    }
+    transaction = s->queue[s->queueReadIndex];
+    s->queueReadIndex = (s->queueReadIndex + 1) % I2C_QUEUE_SIZE;
+    s->active = transaction;
+    s->retries = 0;
+    beginI2cTransaction(i2c, transaction);
+}
+
+void completeI2cTransaction(uint8_t i2c, I2C_TRANSACTION* transaction, I2C_STATUS status)
+{
+    I2C_STATS* stats = &i2cState[i2c].stats;
+    uint32_t latency = getCycleCount() - transaction->queueTime;
+    transaction->latency = latency;
+    transaction->status = status;
+    stats->count++;
+    if (status != I2C_OK)
+        stats->errorCount++;
+    if (latency < stats->minLatency)
+        stats->minLatency = latency;
+    if (latency > stats->maxLatency)
+        stats->maxLatency = latency;
+    stats->totalLatency += latency;
+    transaction->done = true;
+    // Start the next transfer before the callback so the bus stays busy
+    startI2cTransaction(i2c);
+    if (transaction->callback)
+        transaction->callback(transaction);
+}
+
+// Adds a transaction to the queue and returns false if the queue is full
+// The transaction must stay in scope until done is set
+bool queueI2cTransaction(uint8_t i2c, I2C_TRANSACTION* transaction)
+{
+    const I2C_DESCRIPTOR* d = &i2cDescriptor[i2c];
+    I2C_STATE* s = &i2cState[i2c];
+    uint8_t next;
+    bool ok = false;
+    transaction->done = false;
+    transaction->status = I2C_OK;
+    transaction->queueTime = getCycleCount();
+    disableNvicInterrupt(d->vector);
+    next = (s->queueWriteIndex + 1) % I2C_QUEUE_SIZE;
+    if (next != s->queueReadIndex)
+    {
+        s->queue[s->queueWriteIndex] = transaction;
+        s->queueWriteIndex = next;
+        if (s->active == 0)
+            startI2cTransaction(i2c);
+        ok = true;
+    }
+    enableNvicInterrupt(d->vector);
+    return ok;
+}
+
+// Blocking function that queues a transaction and waits for it to complete
+// Each wait is bounded by the timeout of the transactions ahead of it
+I2C_STATUS runI2cTransaction(uint8_t i2c, I2C_TRANSACTION* transaction)
+{
+    while (!queueI2cTransaction(i2c, transaction))
+        checkI2cTimeout(i2c);
+    while (!transaction->done)
+        checkI2cTimeout(i2c);
+    i2cState[i2c].lastStatus = transaction->status;
+    return transaction->status;
+}
+
+bool isI2cBusy(uint8_t i2c)
+{
+    return i2cState[i2c].active != 0;
+}
+
+// Aborts the active transaction if the bus has not progressed within the timeout
+// Called by the blocking functions; users of queueI2cTransaction should call it
+// periodically (from a timer tick or main loop)
+void checkI2cTimeout(uint8_t i2c)
+{
+    const I2C_DESCRIPTOR* d = &i2cDescriptor[i2c];
+    I2C_STATE* s = &i2cState[i2c];
+    I2C_TRANSACTION* transaction;
+    I2C_STATUS status;
+    disableNvicInterrupt(d->vector);
+    transaction = s->active;
+    if (transaction != 0 && (getCycleCount() - s->progressTime) > s->timeout)
+    {
+        s->stats.timeoutCount++;
+        status = recoverI2cBus(i2c);
+        if (status == I2C_OK)
+            status = (s->phase == PHASE_STOP) ? s->nackStatus : I2C_TIMEOUT;
+        completeI2cTransaction(i2c, transaction, status);
+    }
+    enableNvicInterrupt(d->vector);
+}
+
+void getI2cStats(uint8_t i2c, I2C_STATS* stats)
+{
+    uint8_t vector = i2cDescriptor[i2c].vector;
+    disableNvicInterrupt(vector);
+    *stats = i2cState[i2c].stats;
+    enableNvicInterrupt(vector);
+}
+
+void clearI2cStats(uint8_t i2c)
+{
+    uint8_t vector = i2cDescriptor[i2c].vector;
+    I2C_STATS* stats = &i2cState[i2c].stats;
+    disableNvicInterrupt(vector);
+    stats->count = 0;
+    stats->errorCount = 0;
+    stats->arbitrationLostCount = 0;
+    stats->timeoutCount = 0;
+    stats->recoveryCount = 0;
+    stats->minLatency = 0xFFFFFFFF;
+    stats->maxLatency = 0;
+    stats->totalLatency = 0;
+    enableNvicInterrupt(vector);
+}
+
+// Advances the active transaction by one byte
+void i2cIsr(uint8_t i2c)
+{
+    uint32_t base = i2cDescriptor[i2c].base;
+    I2C_STATE* s = &i2cState[i2c];
+    I2C_TRANSACTION* transaction = s->active;
+    uint32_t status;
+    uint8_t data;
+    I2C_MICR(base) = I2C_MICR_IC;
+    if (transaction == 0)
+        return;
+    if (s->phase == PHASE_STOP)
+    {
+        completeI2cTransaction(i2c, transaction, s->nackStatus);
+        return;
+    }
+    status = I2C_MCS(base);
+    if (status & I2C_MCS_ARBLST)
+    {
+        // The winner owns the bus; the module waits for it to go idle before restarting
+        s->stats.arbitrationLostCount++;
+        if (s->retries++ < I2C_ARBITRATION_RETRIES)
+            beginI2cTransaction(i2c, transaction);
+        else
+            completeI2cTransaction(i2c, transaction, I2C_ARBITRATION_LOST);
+        return;
+    }
+    if (status & I2C_MCS_ERROR)
+    {
+        // Release the bus after a nack; the transaction completes on the interrupt
+        // that ends the stop, or in checkI2cTimeout() if it does not arrive
+        s->nackStatus = (status & I2C_MCS_ADRACK) ? I2C_ADDRESS_NACK : I2C_DATA_NACK;
+        if (!s->stopSent)
+        {
+            s->phase = PHASE_STOP;
+            commandI2c(i2c, I2C_MCS_STOP);
+        }
+        else
+            completeI2cTransaction(i2c, transaction, s->nackStatus);
+        return;
+    }
+    if (s->phase == PHASE_WRITE)
+    {
+        s->index++;
+        if (s->index < s->writeCount)
+        {
+            I2C_MDR(base) = getI2cWriteByte(transaction, s->index);
+            commandI2c(i2c, I2C_MCS_RUN
+                            | ((s->index == s->writeCount - 1 && transaction->readSize == 0) ? I2C_MCS_STOP : 0));
+        }
+        else if (transaction->readSize > 0)
+            startI2cRead(i2c, transaction);
+        else
+            completeI2cTransaction(i2c, transaction, I2C_OK);
+    }
+    else
+    {
+        data = I2C_MDR(base);
+        if (s->index < transaction->readSize)
+            transaction->readData[s->index] = data;
+        s->index++;
+        if (s->index < s->readCount)
+            commandI2c(i2c, I2C_MCS_RUN | ((s->index == s->readCount - 1) ? I2C_MCS_STOP : I2C_MCS_ACK));
+        else
+            completeI2cTransaction(i2c, transaction, I2C_OK);
+    }
+}
+
+void i2c0Isr(void)
+{
+    i2cIsr(0);
+}
+
+void i2c1Isr(void)
+{
+    i2cIsr(1);
+}
+
+void i2c2Isr(void)
+{
+    i2cIsr(2);
+}
+
+void i2c3Isr(void)
+{
+    i2cIsr(3);
+}
+
+// Blocking wrappers
+// These wait on the isr, so they cannot be called with interrupts disabled
+// or from an isr of equal or higher priority than the I2C module
+// Reads return 0 on error; use getI2cStatus for the reason
+
+// For simple devices with a single internal register
+I2C_STATUS writeI2cData(uint8_t i2c, uint8_t add, uint8_t data)
+{
+    I2C_TRANSACTION transaction;
+    prepareI2cTransaction(&transaction, add, 0, 0);
+    transaction.writeData = &data;
+    transaction.writeSize = 1;
+    return runI2cTransaction(i2c, &transaction);
+}
+
+uint8_t readI2cData(uint8_t i2c, uint8_t add)
+{
+    uint8_t data = 0;
+    I2C_TRANSACTION transaction;
+    prepareI2cTransaction(&transaction, add, 0, 0);
+    transaction.readData = &data;
+    transaction.readSize = 1;
+    runI2cTransaction(i2c, &transaction);
+    return data;
+}
+
+// For devices with multiple registers
+I2C_STATUS writeI2cRegister(uint8_t i2c, uint8_t add, uint8_t reg, uint8_t data)
+{
+    I2C_TRANSACTION transaction;
+    prepareI2cTransaction(&transaction, add, I2C_REGISTER, reg);
+    transaction.writeData = &data;
+    transaction.writeSize = 1;
+    return runI2cTransaction(i2c, &transaction);
+}
+
+I2C_STATUS writeI2cRegisters(uint8_t i2c, uint8_t add, uint8_t reg, const uint8_t data[], uint8_t size)
+{
+    I2C_TRANSACTION transaction;
+    prepareI2cTransaction(&transaction, add, I2C_REGISTER, reg);
+    transaction.writeData = data;
+    transaction.writeSize = size;
+    return runI2cTransaction(i2c, &transaction);
+}
+
+uint8_t readI2cRegister(uint8_t i2c, uint8_t add, uint8_t reg)
+{
+    uint8_t data = 0;
+    I2C_TRANSACTION transaction;
+    prepareI2cTransaction(&transaction, add, I2C_REGISTER, reg);
+    transaction.readData = &data;
+    transaction.readSize = 1;
+    runI2cTransaction(i2c, &transaction);
+    return data;
+}
+
+I2C_STATUS readI2cRegisters(uint8_t i2c, uint8_t add, uint8_t reg, uint8_t data[], uint8_t size)
+{
+    I2C_TRANSACTION transaction;
+    prepareI2cTransaction(&transaction, add, I2C_REGISTER, reg);
+    transaction.readData = data;
+    transaction.readSize = size;
+    return runI2cTransaction(i2c, &transaction);
+}
+
+bool pollI2cAddress(uint8_t i2c, uint8_t add)
+{
+    I2C_TRANSACTION transaction;
+    prepareI2cTransaction(&transaction, add, 0, 0);
+    transaction.readData = &i2cDummy;
+    transaction.readSize = 1;
+    return runI2cTransaction(i2c, &transaction) == I2C_OK;
+}
+
+bool isI2cError(uint8_t i2c)
+{
+    return i2cState[i2c].lastStatus != I2C_OK;
+}
+
+// Status of the last blocking call
+I2C_STATUS getI2cStatus(uint8_t i2c)
+{
+    return i2cState[i2c].lastStatus;
+}
@@ -0,0 +1,120 @@
+// I2C Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// I2C Interfaces (SCL, SDA), each with 2kohm pullups on SDA and SCL:
+//   I2C0 on PB2, PB3
+//   I2C1 on PA6, PA7
+//   I2C2 on PE4, PE5
+//   I2C3 on PD0, PD1
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef I2C_H_
+#define I2C_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define I2C_COUNT 4
+#define I2C_QUEUE_SIZE 8
+#define I2C_MAX_BIT_RATE 1000000   // fast-mode plus
+#define I2C_DEFAULT_TIMEOUT 40000  // cycles without bus progress (1ms at 40MHz)
+#define I2C_ARBITRATION_RETRIES 3
+
+// Transaction flags
+#define I2C_REGISTER 1             // send reg ahead of the write data
+
+typedef enum _I2C_STATUS
+{
+    I2C_OK,
+    I2C_ADDRESS_NACK,            // no device acknowledged the address
+    I2C_DATA_NACK,               // device refused a written byte
+    I2C_ARBITRATION_LOST,        // another master won the bus on every retry
+    I2C_TIMEOUT,                 // no progress within the timeout (SCL held low)
+    I2C_BUS_STUCK                // SDA still low after bus recovery
+} I2C_STATUS;
+
+struct _I2C_TRANSACTION;
+typedef void (*I2C_CALLBACK)(struct _I2C_TRANSACTION* transaction);
+
+// Write phase (reg then writeData) is followed by a repeated start read phase
+// Either phase may be empty; a transaction with neither only addresses the device
+typedef struct _I2C_TRANSACTION
+{
+    uint8_t address;
+    uint8_t flags;
+    uint8_t reg;
+    const uint8_t* writeData;
+    uint8_t writeSize;
+    uint8_t* readData;
+    uint8_t readSize;
+    I2C_CALLBACK callback;       // called from the isr when done, or 0
+    volatile bool done;
+    volatile I2C_STATUS status;
+    uint32_t queueTime;          // cycle count when queued
+    uint32_t latency;            // cycles from queued to done
+} I2C_TRANSACTION;
+
+typedef struct _I2C_STATS
+{
+    uint32_t count;              // completed transactions
+    uint32_t errorCount;         // transactions completed with an error
+    uint32_t arbitrationLostCount;
+    uint32_t timeoutCount;
+    uint32_t recoveryCount;      // 9-clock bus recoveries
+    uint32_t minLatency;         // cycles
+    uint32_t maxLatency;         // cycles
+    uint64_t totalLatency;       // cycles, for the average
+} I2C_STATS;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initI2c(uint8_t i2c);
+uint32_t setI2cBitRate(uint8_t i2c, uint32_t bitRate, uint32_t fcyc);
+uint32_t measureI2cBitRate(uint8_t i2c, uint8_t add, uint32_t fcyc);
+void setI2cTimeout(uint8_t i2c, uint32_t cycles);
+
+// For simple devices with a single internal register
+I2C_STATUS writeI2cData(uint8_t i2c, uint8_t add, uint8_t data);
+uint8_t readI2cData(uint8_t i2c, uint8_t add);
+
+// For devices with multiple registers
+I2C_STATUS writeI2cRegister(uint8_t i2c, uint8_t add, uint8_t reg, uint8_t data);
+I2C_STATUS writeI2cRegisters(uint8_t i2c, uint8_t add, uint8_t reg, const uint8_t data[], uint8_t size);
+uint8_t readI2cRegister(uint8_t i2c, uint8_t add, uint8_t reg);
+I2C_STATUS readI2cRegisters(uint8_t i2c, uint8_t add, uint8_t reg, uint8_t data[], uint8_t size);
+
+// General functions
+bool pollI2cAddress(uint8_t i2c, uint8_t add);
+bool isI2cError(uint8_t i2c);
+I2C_STATUS getI2cStatus(uint8_t i2c);
+I2C_STATUS recoverI2cBus(uint8_t i2c);
+
+// Non-blocking transactions
+// Each module has its own queue, so transactions on separate buses run concurrently
+bool queueI2cTransaction(uint8_t i2c, I2C_TRANSACTION* transaction);
+I2C_STATUS runI2cTransaction(uint8_t i2c, I2C_TRANSACTION* transaction);
+bool isI2cBusy(uint8_t i2c);
+void checkI2cTimeout(uint8_t i2c);
+void getI2cStats(uint8_t i2c, I2C_STATS* stats);
+void clearI2cStats(uint8_t i2c);
+
+void i2c0Isr(void);
+void i2c1Isr(void);
+void i2c2Isr(void);
+void i2c3Isr(void);
+
+#endif
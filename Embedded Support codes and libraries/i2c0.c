@@ -1,6 +1,9 @@
 // I2C0 Library
 // Jason Losh
 
+// I2C0 instance of the I2C library (i2c.c)
+// Hook in i2c0Isr to I2C0 IVT entry
+
 //-----------------------------------------------------------------------------
 // Hardware Target
 //-----------------------------------------------------------------------------
@@ -18,187 +21,113 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "tm4c123gh6pm.h"
-#include "gpio.h"
+#include "i2c.h"
 #include "i2c0.h"
 
-// PortB masks
-#define SDA_MASK 8
-#define SCL_MASK 4
-
-// Pins
-#define I2C0SCL PORTB,2
-#define I2C0SDA PORTB,3
-
-//-----------------------------------------------------------------------------
-// Global variables
-//-----------------------------------------------------------------------------
-
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
 void initI2c0(void)
 {
-    // Enable clocks
-    SYSCTL_RCGCI2C_R |= SYSCTL_RCGCI2C_R0;
-    _delay_cycles(3);
-    enablePort(PORTB);
+    initI2c(0);
+}
 
-    // Configure I2C
-    selectPinPushPullOutput(I2C0SCL);
-    setPinAuxFunction(I2C0SCL, GPIO_PCTL_PB2_I2C0SCL);
-    selectPinOpenDrainOutput(I2C0SDA);
-    setPinAuxFunction(I2C0SDA, GPIO_PCTL_PB3_I2C0SDA);
+// Set bit rate as function of instruction cycle frequency
+uint32_t setI2c0BitRate(uint32_t bitRate, uint32_t fcyc)
+{
+    return setI2cBitRate(0, bitRate, fcyc);
+}
 
-    // Configure I2C0 peripheral
-    I2C0_MCR_R = 0;                                     // disable to program
-    I2C0_MTPR_R = 19;                                   // (40MHz/2) / (6+4) / (19+1) = 100kbps
-    I2C0_MCR_R = I2C_MCR_MFE;                           // master
-    I2C0_MCS_R = I2C_MCS_STOP;
+uint32_t measureI2c0BitRate(uint8_t add, uint32_t fcyc)
+{
+    return measureI2cBitRate(0, add, fcyc);
+}
+
+void setI2c0Timeout(uint32_t cycles)
+{
+    setI2cTimeout(0, cycles);
 }
 
 // For simple devices with a single internal register
-void writeI2c0Data(uint8_t add, uint8_t data)
+I2C0_STATUS writeI2c0Data(uint8_t add, uint8_t data)
 {
-    I2C0_MSA_R = add << 1 | 0; // add:r/~w=0
-    I2C0_MDR_R = data;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    return writeI2cData(0, add, data);
 }
 
 uint8_t readI2c0Data(uint8_t add)
 {
-    I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    return I2C0_MDR_R;
+    return readI2cData(0, add);
 }
 
 // For devices with multiple registers
-void writeI2c0Register(uint8_t add, uint8_t reg, uint8_t data)
-{
-    // send address and register
-    I2C0_MSA_R = add << 1; // add:r/~w=0
-    I2C0_MDR_R = reg;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-
-    // write data to register
-    I2C0_MDR_R = data;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
-    while (!(I2C0_MRIS_R & I2C_MRIS_RIS));
-}
-
-void writeI2c0Registers(uint8_t add, uint8_t reg, const uint8_t data[], uint8_t size)
-{
-    uint8_t i;
-    // send address and register
-    I2C0_MSA_R = add << 1; // add:r/~w=0
-    I2C0_MDR_R = reg;
-    if (size == 0)
-    {
-        I2C0_MICR_R = I2C_MICR_IC;
-        I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
-        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    }
-    else
-    {
-        I2C0_MICR_R = I2C_MICR_IC;
-        I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
-        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-        // first size-1 bytes
-        for (i = 0; i < size-1; i++)
-        {
-            I2C0_MDR_R = data[i];
-            I2C0_MICR_R = I2C_MICR_IC;
-            I2C0_MCS_R = I2C_MCS_RUN;
-            while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-        }
-        // last byte
-        I2C0_MDR_R = data[size-1];
-        I2C0_MICR_R = I2C_MICR_IC;
-        I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
-        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    }
+I2C0_STATUS writeI2c0Register(uint8_t add, uint8_t reg, uint8_t data)
+{
+    return writeI2cRegister(0, add, reg, data);
+}
+
+I2C0_STATUS writeI2c0Registers(uint8_t add, uint8_t reg, const uint8_t data[], uint8_t size)
+{
+    return writeI2cRegisters(0, add, reg, data, size);
 }
 
 uint8_t readI2c0Register(uint8_t add, uint8_t reg)
 {
-    // set internal register counter in device
-    I2C0_MSA_R = add << 1 | 0; // add:r/~w=0
-    I2C0_MDR_R = reg;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-
-    // read data from register
-    I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    return I2C0_MDR_R;
-}
-
-void readI2c0Registers(uint8_t add, uint8_t reg, uint8_t data[], uint8_t size)
-{
-    uint8_t i = 0;
-    // send address and register number
-    I2C0_MSA_R = add << 1; // add:r/~w=0
-    I2C0_MDR_R = reg;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-
-    if (size == 1)
-    {
-        // add and read one byte
-        I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
-        I2C0_MICR_R = I2C_MICR_IC;
-        I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
-        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-        data[i++] = I2C0_MDR_R;
-    }
-    else if (size > 1)
-    {
-        // add and first byte of read with ack
-        I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
-        I2C0_MICR_R = I2C_MICR_IC;
-        I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_ACK;
-        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-        data[i++] = I2C0_MDR_R;
-        // read size-2 bytes with ack
-        while (i < size-1)
-        {
-            I2C0_MICR_R = I2C_MICR_IC;
-            I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_ACK;
-            while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-            data[i++] = I2C0_MDR_R;
-        }
-        // last byte of read with nack
-        I2C0_MICR_R = I2C_MICR_IC;
-        I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
-        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-        data[i++] = I2C0_MDR_R;
-    }
+    return readI2cRegister(0, add, reg);
+}
+
+I2C0_STATUS readI2c0Registers(uint8_t add, uint8_t reg, uint8_t data[], uint8_t size)
+{
+    return readI2cRegisters(0, add, reg, data, size);
 }
 
 bool pollI2c0Address(uint8_t add)
 {
-    I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    return !(I2C0_MCS_R & I2C_MCS_ERROR);
+    return pollI2cAddress(0, add);
 }
 
 bool isI2c0Error(void)
 {
-    return (I2C0_MCS_R & I2C_MCS_ERROR);
+    return isI2cError(0);
+}
+
+I2C0_STATUS getI2c0Status(void)
+{
+    return getI2cStatus(0);
 }
 
+I2C0_STATUS recoverI2c0Bus(void)
+{
+    return recoverI2cBus(0);
+}
 
+// Non-blocking function that queues a transaction
+bool queueI2c0Transaction(I2C0_TRANSACTION* transaction)
+{
+    return queueI2cTransaction(0, transaction);
+}
+
+I2C0_STATUS runI2c0Transaction(I2C0_TRANSACTION* transaction)
+{
+    return runI2cTransaction(0, transaction);
+}
+
+bool isI2c0Busy(void)
+{
+    return isI2cBusy(0);
+}
+
+void checkI2c0Timeout(void)
+{
+    checkI2cTimeout(0);
+}
+
+void getI2c0Stats(I2C0_STATS* stats)
+{
+    getI2cStats(0, stats);
+}
+
+void clearI2c0Stats(void)
+{
+    clearI2cStats(0);
+}
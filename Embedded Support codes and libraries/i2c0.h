@@ -21,25 +21,47 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "i2c.h"
+
+#define I2C0_QUEUE_SIZE I2C_QUEUE_SIZE
+#define I2C0_MAX_BIT_RATE I2C_MAX_BIT_RATE
+#define I2C0_REGISTER I2C_REGISTER
+
+typedef I2C_TRANSACTION I2C0_TRANSACTION;
+typedef I2C_CALLBACK I2C0_CALLBACK;
+typedef I2C_STATS I2C0_STATS;
+typedef I2C_STATUS I2C0_STATUS;
 
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
 void initI2c0(void);
+uint32_t setI2c0BitRate(uint32_t bitRate, uint32_t fcyc);
+uint32_t measureI2c0BitRate(uint8_t add, uint32_t fcyc);
+void setI2c0Timeout(uint32_t cycles);
 // For simple devices with a single internal register
-void writeI2c0Data(uint8_t add, uint8_t data);
+I2C0_STATUS writeI2c0Data(uint8_t add, uint8_t data);
 uint8_t readI2c0Data(uint8_t add);
 
 // For devices with multiple registers
-void writeI2c0Register(uint8_t add, uint8_t reg, uint8_t data);
-void writeI2c0Registers(uint8_t add, uint8_t reg, const uint8_t data[], uint8_t size);
+I2C0_STATUS writeI2c0Register(uint8_t add, uint8_t reg, uint8_t data);
+I2C0_STATUS writeI2c0Registers(uint8_t add, uint8_t reg, const uint8_t data[], uint8_t size);
 uint8_t readI2c0Register(uint8_t add, uint8_t reg);
-void readI2c0Registers(uint8_t add, uint8_t reg, uint8_t data[], uint8_t size);
+I2C0_STATUS readI2c0Registers(uint8_t add, uint8_t reg, uint8_t data[], uint8_t size);
 
 // General functions
 bool pollI2c0Address(uint8_t add);
 bool isI2c0Error(void);
+I2C0_STATUS getI2c0Status(void);
+I2C0_STATUS recoverI2c0Bus(void);
 
-#endif
+// Non-blocking transactions
+bool queueI2c0Transaction(I2C0_TRANSACTION* transaction);
+I2C0_STATUS runI2c0Transaction(I2C0_TRANSACTION* transaction);
+bool isI2c0Busy(void);
+void checkI2c0Timeout(void);
+void getI2c0Stats(I2C0_STATS* stats);
+void clearI2c0Stats(void);
 
+#endif
@@ -13,6 +13,7 @@
 // HD44780-based 16x2, 20x2, 16x4 20x4 LCD display
 // Display driven by PCF8574 I2C 8-bit I/O expander at address 0x27
 // I2C devices on I2C bus 0 with 2kohm pullups on SDA and SCL
+// The PCF8574 is rated for 100kbps, so I2C0 is left at the initI2c0() default
 // Display RS, R/W, E, backlight enable, and D4-7 connected to PCF8574 P0-7
 
 //-----------------------------------------------------------------------------
@@ -22,6 +23,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "tm4c123gh6pm.h"
 #include "i2c0.h"
 #include "i2c0_lcd.h"
@@ -33,32 +35,71 @@
 #define LCD_E  4
 #define LCD_BACKLIGHT 8
 
+// Longest run is a cursor command and a full row, 4 expander bytes each
+#define LCD_PACKET_SIZE ((LCD_COLS + 1) * 4)
+
 //-----------------------------------------------------------------------------
 // Global variables
 //-----------------------------------------------------------------------------
 
+// Requested text and the text on the display
+char lcdText[LCD_ROWS][LCD_COLS];
+char lcdShadow[LCD_ROWS][LCD_COLS];
+bool lcdDeferred = false;
+
+uint8_t lcdPacket[LCD_PACKET_SIZE];
+uint8_t lcdPacketSize;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
+// Adds the E high, E low expander writes for both nibbles of a byte to the packet
+// The HD44780 latches on the falling edge of E and needs 37us after each byte
+// Only the 2 expander bytes (18 bit times) after the last latch of a byte pass
+// before the first latch of the next, which is 180us at 100kbps and 45us at
+// 400kbps, but 18us at 1Mbps, so packets are not safe above ~450kbps
+void packTextLcdByte(uint8_t value, uint8_t rs)
+{
+    uint8_t* p = &lcdPacket[lcdPacketSize];
+    p[0] = (value & 0xF0) | LCD_E | rs | LCD_BACKLIGHT;
+    p[1] = (value & 0xF0) | rs | LCD_BACKLIGHT;
+    p[2] = (value << 4) | LCD_E | rs | LCD_BACKLIGHT;
+    p[3] = (value << 4) | rs | LCD_BACKLIGHT;
+    lcdPacketSize += 4;
+}
+
+// Sends the packet as a single I2C write to the expander
+I2C0_STATUS sendTextLcdPacket()
+{
+    I2C0_STATUS status = I2C_OK;
+    I2C0_TRANSACTION transaction;
+    memset(&transaction, 0, sizeof(transaction));
+    transaction.address = LCD_ADD;
+    transaction.writeData = lcdPacket;
+    transaction.writeSize = lcdPacketSize;
+    if (lcdPacketSize > 0)
+        status = runI2c0Transaction(&transaction);
+    lcdPacketSize = 0;
+    return status;
+}
+
 void writeTextLcdCommand(uint8_t command)
 {
-    writeI2c0Data(LCD_ADD, (command & 0xF0) | LCD_E | LCD_BACKLIGHT);
-    writeI2c0Data(LCD_ADD, (command & 0xF0) | LCD_BACKLIGHT);
-    writeI2c0Data(LCD_ADD, (command << 4) | LCD_E | LCD_BACKLIGHT);
-    writeI2c0Data(LCD_ADD, (command << 4) | LCD_BACKLIGHT);
+    packTextLcdByte(command, 0);
+    sendTextLcdPacket();
 }
 
 void writeTextLcdData(char c)
 {
-    writeI2c0Data(LCD_ADD, (c & 0xF0) | LCD_E | LCD_RS | LCD_BACKLIGHT);
-    writeI2c0Data(LCD_ADD, (c & 0xF0) | LCD_RS | LCD_BACKLIGHT);
-    writeI2c0Data(LCD_ADD, (c << 4) | LCD_E | LCD_RS | LCD_BACKLIGHT);
-    writeI2c0Data(LCD_ADD, (c << 4) | LCD_RS | LCD_BACKLIGHT);
+    packTextLcdByte(c, LCD_RS);
+    sendTextLcdPacket();
 }
 
 void initLcd()
 {
+    uint8_t r, c;
+
     initI2c0();
 
     // Wait for device to come out of reset
@@ -68,19 +109,78 @@ void initLcd()
     // Note: If device was not reset, the device could already be in 4-bit mode
     //       If this is the case, then this single E cycle will corrupt phase of writes
     //       and the display will likely only initialize correctly every other time
-    writeI2c0Data(LCD_ADD, 0x20 | LCD_E);
-    writeI2c0Data(LCD_ADD, 0x20);
+    lcdPacket[0] = 0x20 | LCD_E;
+    lcdPacket[1] = 0x20;
+    lcdPacketSize = 2;
+    sendTextLcdPacket();
 
     // Continue configuration using dual E cycle (2 nibble) writes
     writeTextLcdCommand(0x28); // 4-bit interface, 2 lines, 5x8 font
     writeTextLcdCommand(0x0C); // display on, no cursor, no blink
     writeTextLcdCommand(0x06); // shift cursor to right after writes
+
+    // Clear so the display matches the shadow
+    writeTextLcdCommand(0x01);
+    waitMicrosecond(2000);
+    for (r = 0; r < LCD_ROWS; r++)
+        for (c = 0; c < LCD_COLS; c++)
+            lcdText[r][c] = lcdShadow[r][c] = ' ';
+}
+
+// Sends the cells that differ from the shadow
+// Changed cells are grouped into runs that start with a cursor command, and a
+// gap of one unchanged cell is resent rather than starting a new run (same cost)
+// The shadow is only updated for runs the expander acked, so if a write fails,
+// updating stops and the remaining cells are sent by the next update
+void updateLcd()
+{
+    uint8_t r, c, start, end;
+    for (r = 0; r < LCD_ROWS; r++)
+    {
+        c = 0;
+        while (c < LCD_COLS)
+        {
+            if (lcdText[r][c] == lcdShadow[r][c])
+            {
+                c++;
+                continue;
+            }
+            end = c + 1;
+            while (end < LCD_COLS && (lcdText[r][end] != lcdShadow[r][end]
+                   || (end + 1 < LCD_COLS && lcdText[r][end + 1] != lcdShadow[r][end + 1])))
+                end++;
+            packTextLcdByte(0x80 + (r & 1) * 64 + (r & 2) * 10 + c, 0);
+            for (start = c; c < end; c++)
+                packTextLcdByte(lcdText[r][c], LCD_RS);
+            if (sendTextLcdPacket() != I2C_OK)
+                return;
+            for (c = start; c < end; c++)
+                lcdShadow[r][c] = lcdText[r][c];
+        }
+    }
+}
+
+// When deferred, putsLcd only updates the text until flushLcd is called,
+// so a screen built from several calls is sent as one set of runs
+void setLcdDeferred(bool enable)
+{
+    lcdDeferred = enable;
+    if (!enable)
+        updateLcd();
+}
+
+void flushLcd()
+{
+    updateLcd();
 }
 
 void putsLcd(uint8_t row, uint8_t col, const char str[])
 {
     uint8_t i = 0;
-    writeTextLcdCommand(0x80 + (row & 1) * 64 + (row & 2) * 10 + col);
-    while (str[i] != NULL)
-        writeTextLcdData(str[i++]);
+    if (row >= LCD_ROWS)
+        return;
+    while (str[i] != '\0' && col < LCD_COLS)
+        lcdText[row][col++] = str[i++];
+    if (!lcdDeferred)
+        updateLcd();
 }
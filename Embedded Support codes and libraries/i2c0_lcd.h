@@ -25,12 +25,18 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#define LCD_ROWS 4
+#define LCD_COLS 20
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
 void initLcd();
 void putsLcd(uint8_t row, uint8_t col, const char str[]);
+void updateLcd();
+void setLcdDeferred(bool enable);
+void flushLcd();
 
 #endif
 
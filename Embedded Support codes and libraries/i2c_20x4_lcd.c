@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "tm4c123gh6pm.h"
+#include "clock.h"
 #include "i2c0_lcd.h"
 #include "wait.h"
 
@@ -46,12 +47,16 @@ int main(void)
     initHw();
     initLcd();
 
+    // Build each screen before sending, so only cells that changed are written
+    setLcdDeferred(true);
+
     while(true)
     {
         putsLcd(0, 0, "Line 1 | | | | | | |");
         putsLcd(1, 0, "Line 2 | | | | | | |");
         putsLcd(2, 0, "Line 3 | | | | | | |");
         putsLcd(3, 0, "Line 4 | | | | | | |");
+        flushLcd();
 
         waitMicrosecond(2000000);
 
@@ -59,6 +64,7 @@ int main(void)
         putsLcd(1, 0, "uvwxyzABCDEFGHIJKLMN");
         putsLcd(2, 0, "OPQRSTUVWXYZ12345678");
         putsLcd(3, 0, "90!@#$%^&*()-_+={}[]");
+        flushLcd();
 
         waitMicrosecond(2000000);
     }
@@ -8,7 +8,7 @@
 // Target Platform: EK-TM4C123GXL
 // Target uC:       TM4C123GH6PM
 // System Clock:    40 MHz
-// Stack:           4096 bytes (needed for snprintf)
+// Stack:           4096 bytes (needed for sscanf)
 
 // Hardware configuration:
 // UART Interface:
@@ -18,12 +18,26 @@
 
 // I2C devices on I2C bus 0 with 2kohm pullups on SDA (PB3) and SCL (PB2)
 
+// Batch mode:
+//   The batch command switches the UART to binary frames until an empty frame
+//   Frames are COBS encoded and end with a 0x00 delimiter
+//   Request:  [op][args]...[crc16 lo][crc16 hi]
+//   Response: [op][status][data]...[crc16 lo][crc16 hi], one record per op
+//   A bad crc is answered with a single BATCH_BAD_FRAME record
+//   Ops (status is an I2C0_STATUS, or BATCH_BAD_OP to end the script):
+//     BATCH_WRITE      add reg n data[n]  register write
+//     BATCH_READ       add reg n          register read, returns n bytes
+//     BATCH_WRITE_RAW  add n data[n]      write without a register byte
+//     BATCH_READ_RAW   add n              read without a register byte, returns n bytes
+//     BATCH_DELAY      ms lo, ms hi       wait
+//     BATCH_DUMP       add first last     register range read, returns last-first+1 bytes
+//     BATCH_SCAN                          returns a 16 byte bitmap of responding addresses
+
 //-----------------------------------------------------------------------------
 // Device includes, defines, and assembler directives
 //-----------------------------------------------------------------------------
 
 #include <stdio.h>
-#include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
@@ -32,6 +46,9 @@
 #include "clock.h"
 #include "uart0.h"
 #include "i2c0.h"
+#include "format.h"
+#include "cobs.h"
+#include "wait.h"
 
 // Range of polled devices
 // 0 for general call, 1-3 for compatible i2c variants
@@ -40,6 +57,38 @@
 #define MIN_I2C_ADD 0x08
 #define MAX_I2C_ADD 0x77
 
+// Batch ops
+#define BATCH_WRITE     0x01
+#define BATCH_READ      0x02
+#define BATCH_WRITE_RAW 0x03
+#define BATCH_READ_RAW  0x04
+#define BATCH_DELAY     0x05
+#define BATCH_DUMP      0x06
+#define BATCH_SCAN      0x07
+#define BATCH_BAD_FRAME 0xFE
+#define BATCH_BAD_OP    0xFF
+
+#define MAX_BATCH_REQUEST 256
+#define MAX_BATCH_RESPONSE 1024
+// Records end within MAX_BATCH_RESPONSE; the op and BATCH_BAD_OP that end a full
+// response and the crc follow them
+#define BATCH_RESPONSE_TRAILER 4
+
+// Transactions kept in flight by the bus scan
+#define SCAN_DEPTH (I2C0_QUEUE_SIZE - 1)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+uint8_t batchEncoded[COBS_MAX_ENCODED_SIZE(MAX_BATCH_REQUEST + 2)];
+// A frame of n bytes can decode to n - 1 bytes, which for a full frame is
+// one more than the longest valid request
+uint8_t batchRequest[COBS_MAX_ENCODED_SIZE(MAX_BATCH_REQUEST + 2) - 1];
+uint8_t batchResponse[MAX_BATCH_RESPONSE + BATCH_RESPONSE_TRAILER];
+uint8_t batchResponseEncoded[COBS_MAX_ENCODED_SIZE(MAX_BATCH_RESPONSE + BATCH_RESPONSE_TRAILER) + 1];
+uint8_t scanData[SCAN_DEPTH];
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -81,6 +130,200 @@ uint8_t asciiToUint8(const char str[])
     return data;
 }
 
+// Probes MIN_I2C_ADD-MAX_I2C_ADD with address-only reads and sets a bit in found[]
+// for each address that acks
+// Up to SCAN_DEPTH probes are queued at once, so the bus runs back-to-back
+// instead of waiting on each transaction
+void scanI2c0Bus(uint8_t found[16])
+{
+    I2C0_TRANSACTION probe[SCAN_DEPTH];
+    uint8_t next = MIN_I2C_ADD;
+    uint8_t done = MIN_I2C_ADD;
+    uint8_t slot;
+    memset(found, 0, 16);
+    while (done <= MAX_I2C_ADD)
+    {
+        // keep the queue full
+        while (next <= MAX_I2C_ADD && next - done < SCAN_DEPTH)
+        {
+            slot = next % SCAN_DEPTH;
+            memset(&probe[slot], 0, sizeof(I2C0_TRANSACTION));
+            probe[slot].address = next;
+            probe[slot].readData = &scanData[slot];
+            probe[slot].readSize = 1;
+            if (!queueI2c0Transaction(&probe[slot]))
+                break;
+            next++;
+        }
+        // wait for room if other transactions fill the queue and none are ours
+        if (done == next)
+        {
+            checkI2c0Timeout();
+            continue;
+        }
+        // retire in order
+        slot = done % SCAN_DEPTH;
+        while (!probe[slot].done)
+            checkI2c0Timeout();
+        if (probe[slot].status == I2C_OK)
+            found[done >> 3] |= 1 << (done & 7);
+        done++;
+    }
+}
+
+// Runs the ops in a request and builds the response records
+// Returns the response size
+uint16_t runBatch(const uint8_t request[], uint16_t size, uint8_t response[])
+{
+    uint16_t in = 0;
+    uint16_t out = 0;
+    uint8_t op, add, reg, n, first, last;
+    uint16_t count, i;
+    I2C0_TRANSACTION transaction;
+    bool ok = true;
+    while (ok && in < size)
+    {
+        op = request[in++];
+        response[out++] = op;
+        // worst case record is a full dump
+        ok = out + 1 + 256 <= MAX_BATCH_RESPONSE;
+        switch (op)
+        {
+            case BATCH_WRITE:
+            case BATCH_WRITE_RAW:
+                reg = 0;
+                ok = ok && in + (op == BATCH_WRITE ? 3 : 2) <= size;
+                if (ok)
+                {
+                    add = request[in++];
+                    if (op == BATCH_WRITE)
+                        reg = request[in++];
+                    n = request[in++];
+                    ok = in + n <= size;
+                }
+                if (ok)
+                {
+                    memset(&transaction, 0, sizeof(transaction));
+                    transaction.address = add;
+                    transaction.flags = (op == BATCH_WRITE) ? I2C0_REGISTER : 0;
+                    transaction.reg = reg;
+                    transaction.writeData = &request[in];
+                    transaction.writeSize = n;
+                    response[out++] = runI2c0Transaction(&transaction);
+                    in += n;
+                }
+                break;
+            case BATCH_READ:
+            case BATCH_READ_RAW:
+                reg = 0;
+                ok = ok && in + (op == BATCH_READ ? 3 : 2) <= size;
+                if (ok)
+                {
+                    add = request[in++];
+                    if (op == BATCH_READ)
+                        reg = request[in++];
+                    n = request[in++];
+                    memset(&transaction, 0, sizeof(transaction));
+                    transaction.address = add;
+                    transaction.flags = (op == BATCH_READ) ? I2C0_REGISTER : 0;
+                    transaction.reg = reg;
+                    transaction.readData = &response[out + 1];
+                    transaction.readSize = n;
+                    response[out] = runI2c0Transaction(&transaction);
+                    out += 1 + n;
+                }
+                break;
+            case BATCH_DELAY:
+                ok = ok && in + 2 <= size;
+                if (ok)
+                {
+                    waitMicrosecond(1000 * (request[in] | (request[in + 1] << 8)));
+                    in += 2;
+                    response[out++] = I2C_OK;
+                }
+                break;
+            case BATCH_DUMP:
+                ok = ok && in + 3 <= size;
+                if (ok)
+                {
+                    add = request[in++];
+                    first = request[in++];
+                    last = request[in++];
+                    ok = first <= last;
+                }
+                if (ok)
+                {
+                    // register-addressed reads of up to 128 bytes, stopping at the first error
+                    count = last - first + 1;
+                    response[out] = I2C_OK;
+                    for (i = 0; i < count && response[out] == I2C_OK; i += n)
+                    {
+                        n = (count - i) > 128 ? 128 : count - i;
+                        response[out] = readI2c0Registers(add, first + i, &response[out + 1 + i], n);
+                    }
+                    out += 1 + count;
+                }
+                break;
+            case BATCH_SCAN:
+                if (ok)
+                {
+                    response[out] = I2C_OK;
+                    scanI2c0Bus(&response[out + 1]);
+                    out += 17;
+                }
+                break;
+            default:
+                ok = false;
+        }
+        if (!ok)
+            response[out++] = BATCH_BAD_OP;
+    }
+    return out;
+}
+
+// Exchanges binary frames until an empty frame is received
+void runBatchMode()
+{
+    uint16_t length = 0;
+    uint16_t size, crc;
+    bool overflow = false;
+    uint8_t c;
+    while (true)
+    {
+        c = getcUart0();
+        if (c != COBS_DELIMITER)
+        {
+            if (length < sizeof(batchEncoded))
+                batchEncoded[length++] = c;
+            else
+                overflow = true;
+            continue;
+        }
+        if (length == 0 && !overflow)
+            return;
+        size = overflow ? 0 : decodeCobs(batchEncoded, length, batchRequest);
+        length = 0;
+        overflow = false;
+        if (size >= 2 && calculateCrc16(batchRequest, size - 2)
+                == (batchRequest[size - 2] | (batchRequest[size - 1] << 8)))
+            size = runBatch(batchRequest, size - 2, batchResponse);
+        else
+        {
+            batchResponse[0] = BATCH_BAD_FRAME;
+            batchResponse[1] = BATCH_BAD_OP;
+            size = 2;
+        }
+        crc = calculateCrc16(batchResponse, size);
+        batchResponse[size++] = crc & 0xFF;
+        batchResponse[size++] = crc >> 8;
+        length = encodeCobs(batchResponse, size, batchResponseEncoded);
+        batchResponseEncoded[length++] = COBS_DELIMITER;
+        for (size = 0; size < length; size++)
+            putcUart0(batchResponseEncoded[size]);
+        length = 0;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Main
 //-----------------------------------------------------------------------------
@@ -91,6 +334,7 @@ int main(void)
     char strInput[MAX_CHARS+1];
     char* token;
     char str[80];
+    char* p;
     uint8_t i;
     uint8_t add;
     uint8_t reg;
@@ -100,6 +344,9 @@ int main(void)
     bool found;
     bool valid;
     bool ok;
+    unsigned int kbps;
+    uint32_t rate;
+    uint8_t present[16];
 
     // Initialize hardware
     initHw();
@@ -145,12 +392,15 @@ int main(void)
                 if (regUsed)
                 {
                     writeI2c0Register(add, reg, data);
-                    snprintf(str, sizeof(str), "Writing 0x%02"PRIX8" to address 0x%02"PRIX8", register 0x%02"PRIX8"\n", data, add, reg);
+                    p = formatHex(formatString(str, "Writing 0x"), data, 2, '0');
+                    p = formatHex(formatString(p, " to address 0x"), add, 2, '0');
+                    formatString(formatHex(formatString(p, ", register 0x"), reg, 2, '0'), "\n");
                 }
                 else
                 {
                     writeI2c0Data(add, data);
-                    snprintf(str, sizeof(str), "Writing 0x%02"PRIX8" to address 0x%02"PRIX8"\n", data, add);
+                    p = formatHex(formatString(str, "Writing 0x"), data, 2, '0');
+                    formatString(formatHex(formatString(p, " to address 0x"), add, 2, '0'), "\n");
                 }
                 putsUart0(str);
             }
@@ -177,12 +427,15 @@ int main(void)
                 if (regUsed)
                 {
                     data = readI2c0Register(add, reg);
-                    snprintf(str, sizeof(str), "Read 0x%02hhX from address 0x%02"PRIX8", register 0x%02"PRIX8"\n", data, add, reg);
+                    p = formatHex(formatString(str, "Read 0x"), data, 2, '0');
+                    p = formatHex(formatString(p, " from address 0x"), add, 2, '0');
+                    formatString(formatHex(formatString(p, ", register 0x"), reg, 2, '0'), "\n");
                 }
                 else
                 {
                     data = readI2c0Data(add);
-                    snprintf(str, sizeof(str), "Read 0x%02"PRIX8" from address 0x%02"PRIX8"\n", data, add);
+                    p = formatHex(formatString(str, "Read 0x"), data, 2, '0');
+                    formatString(formatHex(formatString(p, " from address 0x"), add, 2, '0'), "\n");
                 }
                 putsUart0(str);
             }
@@ -194,12 +447,13 @@ int main(void)
             valid = true;
             found = false;
             putsUart0("Devices found: ");
+            scanI2c0Bus(present);
             for (i = MIN_I2C_ADD; i <= MAX_I2C_ADD; i++)
             {
-                if (pollI2c0Address(i))
+                if (present[i >> 3] & (1 << (i & 7)))
                 {
                     found = true;
-                    snprintf(str, sizeof(str), "0x%02"PRIX8" ", i);
+                    formatString(formatHex(formatString(str, "0x"), i, 2, '0'), " ");
                     putsUart0(str);
                 }
             }
@@ -207,6 +461,33 @@ int main(void)
                 putsUart0("(none)");
             putsUart0("\n");
         }
+        if (strcmp(token, "speed") == 0)
+        {
+            valid = true;
+            // Rate in kbps
+            token = strtok(NULL, " ");
+            ok = ok && token != NULL && sscanf(token, "%u", &kbps) == 1;
+            // Optional address used to check the rate on the bus
+            token = strtok(NULL, " \r\n");
+            add = (token != NULL && strlen(token) > 0) ? asciiToUint8(token) : MIN_I2C_ADD;
+            rate = ok ? setI2c0BitRate(kbps * 1000, 40e6) : 0;
+            if (rate > 0)
+            {
+                p = formatUnsigned(formatString(str, "Bit rate set to "), rate, 0, ' ');
+                p = formatUnsigned(formatString(p, " bps, measured "), measureI2c0BitRate(add, 40e6), 0, ' ');
+                formatString(formatHex(formatString(p, " bps using address 0x"), add, 2, '0'), "\n");
+                putsUart0(str);
+            }
+            else
+                putsUart0("Error in speed command (100-1000 kbps, bus must be idle)\n");
+        }
+        if (strcmp(token, "batch") == 0)
+        {
+            valid = true;
+            putsUart0("Batch mode (send an empty frame to exit)\n");
+            runBatchMode();
+            putsUart0("Batch mode ended\n");
+        }
         if (strcmp(token, "help") == 0)
         {
             valid = true;
@@ -218,6 +499,9 @@ int main(void)
 
             putsUart0("    read ADD              Read a byte from a device\n");
             putsUart0("    write ADD DATA        Write a byte to a device\n");
+
+            putsUart0("    speed KBPS [ADD]      Set the bus speed (100, 400 or 1000 kbps)\n");
+            putsUart0("    batch                 Run binary script frames (see source)\n");
         }
         if (!valid)
             putsUart0("Invalid command\n");
@@ -1,6 +1,9 @@
 // PID Controller Example
 // Jason Losh
 
+// Hook in pidIsr to TIMER2A IVT entry
+// Hook in uart0Isr to UART0 IVT entry
+
 //-----------------------------------------------------------------------------
 // Hardware Target
 //-----------------------------------------------------------------------------
@@ -28,6 +31,10 @@
 //   Analog inputs on AIN3 (PE0)
 // Digital feedback:
 //   Quadrature encoder inputs on PhA0 (PD6) and PhB0 (PD7)
+// UART Interface (telemetry):
+//   U0TX (PA1) and U0RX (PA0) are connected to the 2nd controller
+//   The USB on the 2nd controller enumerates to an ICDI interface and a virtual COM port
+//   Configured to 115,200 baud, 8N1; decode with telemetry_decoder
 // 4x4 Keyboard
 //   Column 0-3 open drain outputs on PB0, PB1, PB4, PA6
 //   Rows 0-3 inputs with pull-ups on PE1, PE2, PE3, PA7
@@ -35,7 +42,7 @@
 //   4 Menu Pages:
 //                                   Pg1    Pg 2   Pg3    Pg4    Pg5
 //   1=show Y   2=show U   3=show S  A=Kp   K      Yset   FB     Tcap
-//   4=step     5          6         B=Ki   Imax   Yst1   Ydiv   Ymax
+//   4=step     5=live     6=telem   B=Ki   Imax   Yst1   Ydiv   Ymax
 //   7=man_ccw  8=man_stop 9=man_cw  C=Kd   Dead   Yst2          Umax
 //   *=run/stop 0=zero_qe  #=ent/pg  D=Ko
 
@@ -51,11 +58,16 @@
 #include "clock.h"
 #include "wait.h"
 #include "graphics_lcd.h"
+#include "graphics_lcd_draw.h"
+#include "graphics_lcd_chart.h"
 #include "backlight.h"
 #include "kb.h"
 #include "motor_control.h"
 #include "adc0.h"
 #include "qei0.h"
+#include "format.h"
+#include "uart0.h"
+#include "telemetry.h"
 #include "tm4c123gh6pm.h"
 
 // Feedback mode
@@ -65,6 +77,12 @@
 // Capture count
 #define CAPTURE_SIZE 100
 
+// Live chart samples queued by the isr (power of 2)
+#define LIVE_BUFFER_SIZE 16
+
+// Telemetry record period (ms)
+#define TELEMETRY_PERIOD 10
+
 // Menu
 #define MENU_COUNT 5
 #define MENU_ITEMS 4
@@ -95,6 +113,8 @@
 
     // Feedback variables
     int8_t fbMode = FB_ANALOG;
+    int16_t raw = 0;
+    int32_t position = 0;
     int32_t y = 0;
     uint32_t yDiv = 1;
 
@@ -117,6 +137,22 @@
     int16_t captureBufferU[CAPTURE_SIZE] = {0};
     int16_t captureBufferY[CAPTURE_SIZE] = {0};
 
+    // Live chart variables
+    // samples are taken every tCap ms and each chart column covers 4 samples
+    bool liveMode = false;
+    int16_t livePhase = 0;
+    int16_t liveBufferY[LIVE_BUFFER_SIZE];
+    int16_t liveBufferU[LIVE_BUFFER_SIZE];
+    volatile uint8_t liveWriteIndex = 0;
+    volatile uint8_t liveReadIndex = 0;
+    GRAPHICS_LCD_CHART liveChart;
+
+    // Telemetry variables
+    // pid, adc, and qei records are sent every TELEMETRY_PERIOD ms
+    bool telemetryMode = false;
+    int16_t telemetryPhase = 0;
+    uint32_t timeMs = 0;
+
     // Display variables
     uint8_t displayPage = 0;
     bool displayY = true;
@@ -162,48 +198,37 @@ void drawMenu()
     }
 }
 
+// Draws a value as 4 zero-padded digits in the menu column
+void drawVariable(uint8_t page, int32_t value)
+{
+    char str[12];
+    formatSigned(str, value, 4, '0');
+    str[4] = '\0';
+    setGraphicsLcdTextPosition(104, page);
+    putsGraphicsLcd(str);
+}
+
 void drawVariables()
 {
-    char str[5];
     switch(displayPage)
     {
         case 0:
-            setGraphicsLcdTextPosition(104,1);
-            snprintf(str, sizeof(str), "%04"PRId32, coeffKp);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,3);
-            snprintf(str, sizeof(str), "%04"PRId32, coeffKi);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,5);
-            snprintf(str, sizeof(str), "%04"PRId32, coeffKd);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,7);
-            snprintf(str, sizeof(str), "%04"PRId32, coeffKo);
-            putsGraphicsLcd(str);
+            drawVariable(1, coeffKp);
+            drawVariable(3, coeffKi);
+            drawVariable(5, coeffKd);
+            drawVariable(7, coeffKo);
             break;
         case 1:
-            setGraphicsLcdTextPosition(104,1);
-            snprintf(str, sizeof(str), "%04"PRId32, coeffK);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,3);
-            snprintf(str, sizeof(str), "%04"PRId32, iMax);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,5);
-            snprintf(str, sizeof(str), "%04"PRId32, deadBand);
-            putsGraphicsLcd(str);
+            drawVariable(1, coeffK);
+            drawVariable(3, iMax);
+            drawVariable(5, deadBand);
             setGraphicsLcdTextPosition(104,7);
             putsGraphicsLcd("    ");
             break;
         case 2:
-            setGraphicsLcdTextPosition(104,1);
-            snprintf(str, sizeof(str), "%04"PRId32, ySetPoint);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,3);
-            snprintf(str, sizeof(str), "%04"PRId32, yStep1);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,5);
-            snprintf(str, sizeof(str), "%04"PRId32, yStep2);
-            putsGraphicsLcd(str);
+            drawVariable(1, ySetPoint);
+            drawVariable(3, yStep1);
+            drawVariable(5, yStep2);
             setGraphicsLcdTextPosition(104,7);
             putsGraphicsLcd("    ");
             break;
@@ -213,35 +238,66 @@ void drawVariables()
                 putsGraphicsLcd("AIN ");
             if (fbMode == FB_QE)
                 putsGraphicsLcd("QE  ");
-            setGraphicsLcdTextPosition(104,3);
-            snprintf(str, sizeof(str), "%04"PRId32, yDiv);
-            putsGraphicsLcd(str);
+            drawVariable(3, yDiv);
             setGraphicsLcdTextPosition(104,5);
             putsGraphicsLcd("    ");
             setGraphicsLcdTextPosition(104,7);
             putsGraphicsLcd("    ");
             break;
         case 4:
-            setGraphicsLcdTextPosition(104,1);
-            snprintf(str, sizeof(str), "%04"PRId32, tCap);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,3);
-            snprintf(str, sizeof(str), "%04"PRId32, displayYMax);
-            putsGraphicsLcd(str);
-            setGraphicsLcdTextPosition(104,5);
-            snprintf(str, sizeof(str), "%04"PRId32, displayUMax);
-            putsGraphicsLcd(str);
+            drawVariable(1, tCap);
+            drawVariable(3, displayYMax);
+            drawVariable(5, displayUMax);
             setGraphicsLcdTextPosition(104,7);
             putsGraphicsLcd("    ");
             break;
     }
 }
 
+// Starts a sweeping chart of y, u, and the set point in the plot area
+void startLiveChart()
+{
+    drawGraphicsLcdRectangle(0, 0, 104, 64, CLEAR);
+    initGraphicsLcdChart(&liveChart, 0, 0, 104, 64, 3, 4);
+    setGraphicsLcdChartScale(&liveChart, 0, 0, displayYMax);
+    setGraphicsLcdChartScale(&liveChart, 1, -displayUMax, displayUMax);
+    setGraphicsLcdChartScale(&liveChart, 2, 0, displayYMax);
+    setGraphicsLcdChartTraceVisible(&liveChart, 0, displayY);
+    setGraphicsLcdChartTraceVisible(&liveChart, 1, displayU);
+    setGraphicsLcdChartTraceVisible(&liveChart, 2, displayY);
+    setGraphicsLcdChartSweep(&liveChart, true);
+    liveReadIndex = liveWriteIndex;
+}
+
+// Adds the samples queued by the isr to the live chart
+void drawLiveChart()
+{
+    int16_t values[3];
+    while (liveReadIndex != liveWriteIndex)
+    {
+        values[0] = liveBufferY[liveReadIndex];
+        values[1] = liveBufferU[liveReadIndex];
+        values[2] = ySetPoint;
+        addGraphicsLcdChartSample(&liveChart, values);
+        liveReadIndex = (liveReadIndex + 1) & (LIVE_BUFFER_SIZE - 1);
+    }
+}
+
 void drawPlot()
 {
     uint8_t x;
     uint32_t y, yScaled;
     int32_t uScaled;
+
+    if (liveMode)
+    {
+        startLiveChart();
+        return;
+    }
+
+    // draw into the pixel map and send the changed spans at the end
+    setGraphicsLcdDeferred(true);
+
     // clear graphics area
     drawGraphicsLcdRectangle(0, 0, 104, 64, CLEAR);
 
@@ -252,13 +308,11 @@ void drawPlot()
         if (stepMode)
         {
             y = ((uint32_t)yStep1 * 64) / displayYMax;
-            for (x = 0; x < CAPTURE_SIZE; x++)
-            if (x & 4)
-                drawGraphicsLcdPixel(x, y, SET);
+            for (x = 4; x < CAPTURE_SIZE; x += 8)
+                drawGraphicsLcdHLine(x, y, 4, SET);
             y = ((long)yStep2 * 64) / displayYMax;
-            for (x = 0; x < CAPTURE_SIZE; x++)
-            if (x & 4)
-                drawGraphicsLcdPixel(x, y, SET);
+            for (x = 4; x < CAPTURE_SIZE; x += 8)
+                drawGraphicsLcdHLine(x, y, 4, SET);
         }
         setGraphicsLcdTextPosition(90, 7);
         putcGraphicsLcd('y');
@@ -287,6 +341,9 @@ void drawPlot()
             drawGraphicsLcdPixel(x, 32 - uScaled, SET);
         }
     }
+
+    flushGraphicsLcd();
+    setGraphicsLcdDeferred(false);
 }
 
 void getsKb(char str[], int maxSize, char enterCharacter)
@@ -467,6 +524,15 @@ void processKeyboardData()
                 manualMode = true;
                 u += 10;
                 break;
+            case '5':
+                liveMode = !liveMode;
+                displaySensors = false;
+                drawPlot();
+                break;
+            case '6':
+                telemetryMode = !telemetryMode;
+                telemetryPhase = 0;
+                break;
             case '0':
                 setQei0Position(0);
         }
@@ -479,21 +545,24 @@ void processControlData()
     if (captureDone)
     {
         captureDone = false;
-        drawPlot();
+        if (!liveMode)
+            drawPlot();
     }
+    if (liveMode)
+        drawLiveChart();
     if (displaySensors)
     {
         setGraphicsLcdTextPosition(0, 0);
-        snprintf(str, sizeof(str), "Y = %8"PRId32, y);
+        formatSigned(formatString(str, "Y = "), y, 8, ' ');
         putsGraphicsLcd(str);
         setGraphicsLcdTextPosition(0, 1);
-        snprintf(str, sizeof(str), "E = %8"PRId32, error);
+        formatSigned(formatString(str, "E = "), error, 8, ' ');
         putsGraphicsLcd(str);
         setGraphicsLcdTextPosition(0, 2);
-        snprintf(str, sizeof(str), "I = %8"PRId32, integral);
+        formatSigned(formatString(str, "I = "), integral, 8, ' ');
         putsGraphicsLcd(str);
         setGraphicsLcdTextPosition(0, 3);
-        snprintf(str, sizeof(str), "U = %8"PRId32, u);
+        formatSigned(formatString(str, "U = "), u, 8, ' ');
         putsGraphicsLcd(str);
         waitMicrosecond(250000);
     }
@@ -507,11 +576,14 @@ void pidIsr()
     switch (fbMode)
     {
         case FB_ANALOG:
-            y = readAdc0Ss3() / yDiv;
+            raw = readAdc0Ss3();
+            y = raw / yDiv;
             break;
         case FB_QE:
-            y = getQei0Position() / yDiv;
+            position = getQei0Position();
+            y = position / yDiv;
     }
+    timeMs++;
 
     if (runMode)
     {
@@ -572,6 +644,35 @@ void pidIsr()
             }
         }
     }
+    // queue outputs for the live chart (samples are dropped if the chart falls behind)
+    if (liveMode)
+    {
+        livePhase++;
+        if (livePhase >= tCap)
+        {
+            livePhase = 0;
+            if (((liveWriteIndex + 1) & (LIVE_BUFFER_SIZE - 1)) != liveReadIndex)
+            {
+                liveBufferY[liveWriteIndex] = y;
+                liveBufferU[liveWriteIndex] = u;
+                liveWriteIndex = (liveWriteIndex + 1) & (LIVE_BUFFER_SIZE - 1);
+            }
+        }
+    }
+    // publish telemetry (records are dropped if the uart falls behind)
+    if (telemetryMode)
+    {
+        telemetryPhase++;
+        if (telemetryPhase >= TELEMETRY_PERIOD)
+        {
+            telemetryPhase = 0;
+            sendTelemetryPidSample(timeMs, y, u, ySetPoint);
+            if (fbMode == FB_ANALOG)
+                sendTelemetryAdcReading(timeMs, 3, raw);
+            else
+                sendTelemetryQeiPosition(timeMs, position);
+        }
+    }
     TIMER2_ICR_R = TIMER_ICR_TATOCINT;
 }
 
@@ -592,6 +693,8 @@ int main(void)
     setAdc0Ss3Log2AverageCount(6);
     initQei0();
     setQei0Position(0);
+    initUart0();
+    setUart0BaudRate(115200, 40e6);
     initPidController();
 
     // Two background tasks are now running:
@@ -0,0 +1,358 @@
+// SPI Library
+// Jason Losh
+
+// Bus manager for SSI0-3: devices sharing a bus are registered with their own
+// chip select, mode, bit rate, and frame size, and transactions are queued
+// The module is only reconfigured when consecutive transactions use different devices
+// Hook in ssiNIsr to the SSIN IVT entry of each SSI used
+// Do not use spi1.c on a module managed here; the graphics LCD can join a managed
+// bus with initGraphicsLcdSpiDevice()
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// SPI Interfaces (SCLK, MISO, MOSI):
+//   SSI0 on PA2, PA4, PA5
+//   SSI1 on PD0, PD2, PD3
+//   SSI2 on PB4, PB6, PB7
+//   SSI3 on PD0, PD2, PD3 (shares pins with SSI1)
+// Chip selects are GPIO pins assigned to each device (active low)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "spi.h"
+#include "gpio.h"
+#include "nvic.h"
+
+// Register access relative to the module base address
+#define SSI_CR0(b)      (*((volatile uint32_t *)((b) + 0x000)))
+#define SSI_CR1(b)      (*((volatile uint32_t *)((b) + 0x004)))
+#define SSI_DR(b)       (*((volatile uint32_t *)((b) + 0x008)))
+#define SSI_SR(b)       (*((volatile uint32_t *)((b) + 0x00C)))
+#define SSI_CPSR(b)     (*((volatile uint32_t *)((b) + 0x010)))
+#define SSI_IM(b)       (*((volatile uint32_t *)((b) + 0x014)))
+#define SSI_CC(b)       (*((volatile uint32_t *)((b) + 0xFC8)))
+
+#define SSI_FIFO_DEPTH 8
+#define NO_DEVICE 0xFF
+
+// Fixed hardware description of each module
+typedef struct _SPI_DESCRIPTOR
+{
+    uint32_t base;
+    uint32_t clockMask;
+    PORT port;
+    uint8_t clkPin;
+    uint8_t rxPin;
+    uint8_t txPin;
+    uint8_t pinFunction;
+    uint8_t vector;
+} SPI_DESCRIPTOR;
+
+// Registered device, with register values calculated once
+typedef struct _SPI_DEVICE
+{
+    uint8_t ssi;
+    PORT csPort;
+    uint8_t csPin;
+    uint32_t cr0;
+    uint8_t cpsr;
+    bool wide;                         // frames larger than 8 bits
+} SPI_DEVICE;
+
+// Run-time state of each module
+typedef struct _SPI_STATE
+{
+    uint32_t fcyc;
+    uint8_t device;                    // device the module is configured for
+    SPI_TRANSACTION* queue[SPI_QUEUE_SIZE];
+    volatile uint8_t queueReadIndex;
+    volatile uint8_t queueWriteIndex;
+    SPI_TRANSACTION* volatile active;
+    uint16_t txIndex;
+    uint16_t rxIndex;
+    uint32_t reconfigureCount;
+} SPI_STATE;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const SPI_DESCRIPTOR spiDescriptor[SPI_COUNT] =
+{
+    {0x40008000, SYSCTL_RCGCSSI_R0, PORTA, 2, 4, 5, 2, INT_SSI0},
+    {0x40009000, SYSCTL_RCGCSSI_R1, PORTD, 0, 2, 3, 2, INT_SSI1},
+    {0x4000A000, SYSCTL_RCGCSSI_R2, PORTB, 4, 6, 7, 2, INT_SSI2},
+    {0x4000B000, SYSCTL_RCGCSSI_R3, PORTD, 0, 2, 3, 1, INT_SSI3}
+};
+
+SPI_STATE spiState[SPI_COUNT];
+SPI_DEVICE spiDevice[MAX_SPI_DEVICES];
+uint8_t spiDeviceCount = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Initialize SSI module as a SPI master
+void initSpi(uint8_t ssi, uint32_t fcyc, bool useRx)
+{
+    const SPI_DESCRIPTOR* d = &spiDescriptor[ssi];
+    SPI_STATE* s = &spiState[ssi];
+
+    // Enable clocks
+    SYSCTL_RCGCSSI_R |= d->clockMask;
+    _delay_cycles(3);
+    enablePort(d->port);
+
+    // Configure SSI pins (chip selects are configured per device)
+    selectPinPushPullOutput(d->port, d->txPin);
+    setPinAuxFunction(d->port, d->txPin, d->pinFunction);
+    selectPinPushPullOutput(d->port, d->clkPin);
+    setPinAuxFunction(d->port, d->clkPin, d->pinFunction);
+    if (useRx)
+    {
+        selectPinDigitalInput(d->port, d->rxPin);
+        setPinAuxFunction(d->port, d->rxPin, d->pinFunction);
+    }
+
+    // Configure the SSI as a master; EOT makes the tx interrupt signal an idle bus
+    SSI_CR1(d->base) = 0;
+    SSI_CC(d->base) = 0;                                // select system clock as the clock source
+    SSI_CR1(d->base) = SSI_CR1_EOT;
+    SSI_IM(d->base) = 0;
+
+    s->fcyc = fcyc;
+    s->device = NO_DEVICE;
+    s->queueReadIndex = s->queueWriteIndex = 0;
+    s->active = 0;
+    s->reconfigureCount = 0;
+    enableNvicInterrupt(d->vector);
+}
+
+// Registers a device and returns its handle, or SPI_INVALID_DEVICE
+// Mode 0-3 selects SPO (bit 1) and SPH (bit 0), frame size is 4-16 bits
+// The bit rate is rounded down to the nearest rate available
+uint8_t addSpiDevice(uint8_t ssi, PORT csPort, uint8_t csPin, uint8_t mode,
+                     uint32_t bitRate, uint8_t frameSize)
+{
+    SPI_DEVICE* dev;
+    uint32_t divisor;
+    uint16_t cpsr = 2;
+    uint16_t scr;
+
+    if ((spiDeviceCount == MAX_SPI_DEVICES) || (ssi >= SPI_COUNT) || (bitRate == 0)
+        || (frameSize < 4) || (frameSize > 16))
+        return SPI_INVALID_DEVICE;
+
+    // bit rate = fcyc / (cpsr * (1 + scr)), with cpsr even from 2 to 254
+    divisor = (spiState[ssi].fcyc + bitRate - 1) / bitRate;
+    while ((divisor > cpsr * 256) && (cpsr < 254))
+        cpsr += 2;
+    scr = (divisor + cpsr - 1) / cpsr;
+    scr = (scr == 0) ? 0 : scr - 1;
+    if (scr > 255)
+        scr = 255;
+
+    dev = &spiDevice[spiDeviceCount];
+    dev->ssi = ssi;
+    dev->csPort = csPort;
+    dev->csPin = csPin;
+    dev->cpsr = cpsr;
+    dev->cr0 = (scr << SSI_CR0_SCR_S) | SSI_CR0_FRF_MOTO | (frameSize - 1);
+    if (mode & 2)
+        dev->cr0 |= SSI_CR0_SPO;
+    if (mode & 1)
+        dev->cr0 |= SSI_CR0_SPH;
+    dev->wide = frameSize > 8;
+
+    // Deassert chip select
+    enablePort(csPort);
+    setPinValue(csPort, csPin, 1);
+    selectPinPushPullOutput(csPort, csPin);
+
+    return spiDeviceCount++;
+}
+
+// Starts the next queued transaction, reconfiguring the module only on a device change
+// Called with the module interrupt disabled or from the isr
+void startSpiTransaction(uint8_t ssi)
+{
+    const SPI_DESCRIPTOR* d = &spiDescriptor[ssi];
+    SPI_STATE* s = &spiState[ssi];
+    SPI_TRANSACTION* t;
+    SPI_DEVICE* dev;
+
+    if (s->queueReadIndex == s->queueWriteIndex)
+    {
+        s->active = 0;
+        SSI_IM(d->base) = 0;
+        return;
+    }
+    t = s->queue[s->queueReadIndex];
+    s->queueReadIndex = (s->queueReadIndex + 1) % SPI_QUEUE_SIZE;
+    dev = &spiDevice[t->device];
+
+    if (s->device != t->device)
+    {
+        SSI_CR1(d->base) &= ~SSI_CR1_SSE;               // turn off SSI to allow re-configuration
+        SSI_CR0(d->base) = dev->cr0;
+        SSI_CPSR(d->base) = dev->cpsr;
+        if (dev->cr0 & SSI_CR0_SPO)                     // clock idles high
+            enablePinPullup(d->port, d->clkPin);
+        else
+            disablePinPullup(d->port, d->clkPin);
+        SSI_CR1(d->base) |= SSI_CR1_SSE;
+        s->device = t->device;
+        s->reconfigureCount++;
+    }
+
+    if (t->before)
+        t->before();
+    setPinValue(dev->csPort, dev->csPin, 0);
+    s->active = t;
+    s->txIndex = s->rxIndex = 0;
+    SSI_IM(d->base) = SSI_IM_RXIM | SSI_IM_TXIM;        // the idle bus interrupts at once to start
+}
+
+// Non-blocking function that queues a transaction
+// Returns false if the queue is full or the transaction is invalid
+bool queueSpiTransaction(SPI_TRANSACTION* transaction)
+{
+    uint8_t ssi, next;
+    SPI_STATE* s;
+    bool ok;
+    if ((transaction->device >= spiDeviceCount) || (transaction->size == 0))
+        return false;
+    ssi = spiDevice[transaction->device].ssi;
+    s = &spiState[ssi];
+    transaction->done = false;
+    disableNvicInterrupt(spiDescriptor[ssi].vector);    // isr also updates the queue
+    next = (s->queueWriteIndex + 1) % SPI_QUEUE_SIZE;
+    ok = next != s->queueReadIndex;
+    if (ok)
+    {
+        s->queue[s->queueWriteIndex] = transaction;
+        s->queueWriteIndex = next;
+        if (!s->active)
+            startSpiTransaction(ssi);
+    }
+    enableNvicInterrupt(spiDescriptor[ssi].vector);
+    return ok;
+}
+
+// Returns true if a transaction is in progress or queued
+bool isSpiBusy(uint8_t ssi)
+{
+    return spiState[ssi].active != 0;
+}
+
+// Blocking function that queues a transaction and waits until it completes
+void transferSpi(uint8_t device, const void* txData, void* rxData, uint16_t size)
+{
+    SPI_TRANSACTION transaction;
+    if ((device >= spiDeviceCount) || (size == 0))
+        return;
+    transaction.device = device;
+    transaction.txData = txData;
+    transaction.rxData = rxData;
+    transaction.size = size;
+    transaction.before = 0;
+    transaction.callback = 0;
+    while (!queueSpiTransaction(&transaction));
+    while (!transaction.done);
+}
+
+// Number of times the module was reconfigured for a different device
+uint32_t getSpiReconfigureCount(uint8_t ssi)
+{
+    return spiState[ssi].reconfigureCount;
+}
+
+// Keeps up to a fifo depth of frames in flight, so the rx fifo cannot overrun
+// The rx interrupt (fifo half full) refills during a transaction and the
+// tx interrupt (end of transmission) signals that all frames have been received
+void serviceSpiInterrupt(uint8_t ssi)
+{
+    const SPI_DESCRIPTOR* d = &spiDescriptor[ssi];
+    SPI_STATE* s = &spiState[ssi];
+    SPI_TRANSACTION* t = s->active;
+    SPI_DEVICE* dev;
+    uint32_t data;
+
+    if (!t)
+    {
+        SSI_IM(d->base) = 0;
+        return;
+    }
+    dev = &spiDevice[t->device];
+
+    // Read received frames
+    while (SSI_SR(d->base) & SSI_SR_RNE)
+    {
+        data = SSI_DR(d->base);
+        if (t->rxData)
+        {
+            if (dev->wide)
+                ((uint16_t*)t->rxData)[s->rxIndex] = data;
+            else
+                ((uint8_t*)t->rxData)[s->rxIndex] = data;
+        }
+        s->rxIndex++;
+    }
+
+    // Write frames
+    while ((s->txIndex < t->size) && (s->txIndex - s->rxIndex < SSI_FIFO_DEPTH)
+           && (SSI_SR(d->base) & SSI_SR_TNF))
+    {
+        if (!t->txData)
+            data = 0xFFFF;
+        else if (dev->wide)
+            data = ((const uint16_t*)t->txData)[s->txIndex];
+        else
+            data = ((const uint8_t*)t->txData)[s->txIndex];
+        SSI_DR(d->base) = data;
+        s->txIndex++;
+    }
+
+    // Complete transaction and start the next one
+    if (s->rxIndex >= t->size)
+    {
+        setPinValue(dev->csPort, dev->csPin, 1);
+        t->done = true;
+        if (t->callback)
+            t->callback();
+        startSpiTransaction(ssi);
+    }
+}
+
+void ssi0Isr()
+{
+    serviceSpiInterrupt(0);
+}
+
+void ssi1Isr()
+{
+    serviceSpiInterrupt(1);
+}
+
+void ssi2Isr()
+{
+    serviceSpiInterrupt(2);
+}
+
+void ssi3Isr()
+{
+    serviceSpiInterrupt(3);
+}
@@ -0,0 +1,68 @@
+// SPI Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// SPI Interfaces (SCLK, MISO, MOSI):
+//   SSI0 on PA2, PA4, PA5
+//   SSI1 on PD0, PD2, PD3
+//   SSI2 on PB4, PB6, PB7
+//   SSI3 on PD0, PD2, PD3 (shares pins with SSI1)
+// Chip selects are GPIO pins assigned to each device (active low)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef SPI_H_
+#define SPI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+
+#define SPI_COUNT 4
+#define MAX_SPI_DEVICES 8
+#define SPI_QUEUE_SIZE 8
+#define SPI_INVALID_DEVICE 0xFF
+
+typedef void (*SPI_CALLBACK)(void);
+
+// Transaction owned by the caller until done is set
+// For frame sizes of 9-16 bits, txData and rxData point to uint16_t arrays
+// If txData is 0, all ones are sent; if rxData is 0, received data is discarded
+typedef struct _SPI_TRANSACTION
+{
+    uint8_t device;
+    const void* txData;
+    void* rxData;
+    uint16_t size;                     // frames
+    SPI_CALLBACK before;               // called with the bus idle before cs is asserted, or 0
+    SPI_CALLBACK callback;             // called from the isr after cs is deasserted, or 0
+    volatile bool done;
+} SPI_TRANSACTION;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initSpi(uint8_t ssi, uint32_t fcyc, bool useRx);
+uint8_t addSpiDevice(uint8_t ssi, PORT csPort, uint8_t csPin, uint8_t mode,
+                     uint32_t bitRate, uint8_t frameSize);
+bool queueSpiTransaction(SPI_TRANSACTION* transaction);
+bool isSpiBusy(uint8_t ssi);
+void transferSpi(uint8_t device, const void* txData, void* rxData, uint16_t size);
+uint32_t getSpiReconfigureCount(uint8_t ssi);
+void ssi0Isr();
+void ssi1Isr();
+void ssi2Isr();
+void ssi3Isr();
+
+#endif
@@ -1,6 +1,8 @@
 // SPI1 Library
 // Jason Losh
 
+// For uDMA transfers, hook in spi1Isr to SSI1 IVT entry
+
 //-----------------------------------------------------------------------------
 // Hardware Target
 //-----------------------------------------------------------------------------
@@ -25,6 +27,8 @@
 #include "tm4c123gh6pm.h"
 #include "spi1.h"
 #include "gpio.h"
+#include "nvic.h"
+#include "udma.h"
 
 // Pins
 #define SSI1TX PORTD,3
@@ -32,10 +36,30 @@
 #define SSI1FSS PORTD,1
 #define SSI1CLK PORTD,0
 
+// uDMA channels (encoding 0)
+#define SSI1_RX_DMA_CHANNEL 24
+#define SSI1_TX_DMA_CHANNEL 25
+
+#define SSI1_TX_DMA_CONTROL (UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_8 | \
+                             UDMA_CHCTL_SRCINC_8 | UDMA_CHCTL_SRCSIZE_8 | \
+                             UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERMODE_BASIC)
+#define SSI1_RX_DMA_CONTROL (UDMA_CHCTL_DSTINC_8 | UDMA_CHCTL_DSTSIZE_8 | \
+                             UDMA_CHCTL_SRCINC_NONE | UDMA_CHCTL_SRCSIZE_8 | \
+                             UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERMODE_BASIC)
+
 //-----------------------------------------------------------------------------
 // Global variables
 //-----------------------------------------------------------------------------
 
+// Segment list of the dma write in progress
+const SPI1_SEGMENT* spi1Segments;
+SPI1_SEGMENT spi1SingleSegment;
+uint8_t spi1SegmentCount;
+volatile uint8_t spi1SegmentIndex;
+volatile bool spi1DmaBusy = false;
+bool spi1DmaRx = false;
+SPI1_CALLBACK spi1DmaCallback;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -104,8 +128,180 @@ void writeSpi1Data(uint32_t data)
     while (SSI1_SR_R & SSI_SR_BSY);
 }
 
+// Function that writes data to the tx fifo, waiting only if the fifo is full
+void putSpi1Data(uint32_t data)
+{
+    while (!(SSI1_SR_R & SSI_SR_TNF));
+    SSI1_DR_R = data;
+}
+
+// Blocking function that waits until all data in the tx fifo has been sent
+void waitSpi1Idle()
+{
+    while (SSI1_SR_R & SSI_SR_BSY);
+}
+
 // Reads data from the rx buffer after a write
 uint32_t readSpi1Data()
 {
     return SSI1_DR_R;
 }
+
+// Blocking function that writes a block of data, keeping the tx fifo full,
+// and waits only once at the end of the block until the transfer completes
+// Received data is discarded
+void writeSpi1Block(const uint8_t data[], uint16_t size)
+{
+    uint16_t i;
+    for (i = 0; i < size; i++)
+    {
+        while (!(SSI1_SR_R & SSI_SR_TNF));
+        SSI1_DR_R = data[i];
+    }
+    while (SSI1_SR_R & SSI_SR_BSY);
+}
+
+// Blocking function that writes a block of data and stores the data received
+// Frames in flight are limited to the fifo depth so the rx fifo cannot overrun
+void transferSpi1Block(const uint8_t txData[], uint8_t rxData[], uint16_t size)
+{
+    uint16_t txIndex = 0, rxIndex = 0;
+
+    // discard stale data from earlier writes
+    while (SSI1_SR_R & SSI_SR_RNE)
+        (void)SSI1_DR_R;
+
+    while (rxIndex < size)
+    {
+        if ((txIndex < size) && (txIndex - rxIndex < SPI1_FIFO_DEPTH) && (SSI1_SR_R & SSI_SR_TNF))
+            SSI1_DR_R = txData[txIndex++];
+        if (SSI1_SR_R & SSI_SR_RNE)
+            rxData[rxIndex++] = SSI1_DR_R;
+    }
+}
+
+// Prepares SSI1 for uDMA transfers
+// initUdma() must be called first
+// With EOT set, the tx interrupt indicates the last bit has left the shift register
+void initSpi1Dma()
+{
+    selectUdmaChannelEncoding(SSI1_RX_DMA_CHANNEL, 0);
+    selectUdmaChannelEncoding(SSI1_TX_DMA_CHANNEL, 0);
+    SSI1_CR1_R |= SSI_CR1_EOT;
+    SSI1_IM_R = 0;
+    SSI1_DMACTL_R = 0;
+    spi1DmaBusy = false;
+    enableNvicInterrupt(INT_SSI1);
+}
+
+// Starts the next segment once the bus has drained, or completes the write
+void startSpi1Segment()
+{
+    const SPI1_SEGMENT* segment;
+    if (spi1SegmentIndex < spi1SegmentCount)
+    {
+        segment = &spi1Segments[spi1SegmentIndex++];
+        if (segment->before)
+            segment->before();
+        setUdmaChannelTransfer(SSI1_TX_DMA_CHANNEL, UDMA_PRIMARY, segment->data, &SSI1_DR_R,
+                               SSI1_TX_DMA_CONTROL, segment->size);
+        enableUdmaChannel(SSI1_TX_DMA_CHANNEL);
+        SSI1_DMACTL_R |= SSI_DMACTL_TXDMAE;
+    }
+    else
+    {
+        while (SSI1_SR_R & SSI_SR_RNE)                 // discard data received during the write
+            (void)SSI1_DR_R;
+        spi1DmaBusy = false;
+        if (spi1DmaCallback)
+            spi1DmaCallback();
+    }
+}
+
+// Non-blocking function that writes a list of segments (1-1024 bytes each) using uDMA
+// The before function of each segment is called with the bus idle, so it can
+// change pins (for example a command/data select) before the segment starts
+// The segments and their data must remain valid until the callback is called from the isr
+bool writeSpi1DmaSegments(const SPI1_SEGMENT segments[], uint8_t count, SPI1_CALLBACK callback)
+{
+    uint8_t i;
+    if (spi1DmaBusy || (count == 0))
+        return false;
+    for (i = 0; i < count; i++)
+        if ((segments[i].size == 0) || (segments[i].size > UDMA_MAX_TRANSFER))
+            return false;
+    spi1DmaBusy = true;
+    spi1DmaRx = false;
+    spi1DmaCallback = callback;
+    spi1Segments = segments;
+    spi1SegmentCount = count;
+    spi1SegmentIndex = 0;
+    startSpi1Segment();
+    return true;
+}
+
+// Non-blocking function that writes 1-1024 bytes using uDMA
+bool writeSpi1Dma(const uint8_t data[], uint16_t size, SPI1_CALLBACK callback)
+{
+    if (spi1DmaBusy)
+        return false;
+    spi1SingleSegment.data = data;
+    spi1SingleSegment.size = size;
+    spi1SingleSegment.before = 0;
+    return writeSpi1DmaSegments(&spi1SingleSegment, 1, callback);
+}
+
+// Non-blocking function that writes and reads 1-1024 bytes using uDMA
+// Requires the rx pin (USE_SSI_RX); completion is signaled by the rx channel
+bool transferSpi1Dma(const uint8_t txData[], uint8_t rxData[], uint16_t size, SPI1_CALLBACK callback)
+{
+    if (spi1DmaBusy || (size == 0) || (size > UDMA_MAX_TRANSFER))
+        return false;
+    spi1DmaBusy = true;
+    spi1DmaRx = true;
+    spi1DmaCallback = callback;
+    spi1SegmentCount = spi1SegmentIndex = 0;
+    while (SSI1_SR_R & SSI_SR_RNE)                     // discard stale data from earlier writes
+        (void)SSI1_DR_R;
+    setUdmaChannelTransfer(SSI1_RX_DMA_CHANNEL, UDMA_PRIMARY, &SSI1_DR_R, rxData,
+                           SSI1_RX_DMA_CONTROL, size);
+    setUdmaChannelTransfer(SSI1_TX_DMA_CHANNEL, UDMA_PRIMARY, txData, &SSI1_DR_R,
+                           SSI1_TX_DMA_CONTROL, size);
+    enableUdmaChannel(SSI1_RX_DMA_CHANNEL);
+    enableUdmaChannel(SSI1_TX_DMA_CHANNEL);
+    SSI1_DMACTL_R |= SSI_DMACTL_RXDMAE | SSI_DMACTL_TXDMAE;
+    return true;
+}
+
+// Returns true if a dma write or transfer is in progress
+bool isSpi1DmaBusy()
+{
+    return spi1DmaBusy;
+}
+
+// uDMA completion is signaled on the SSI1 vector
+// A finished tx channel only means the data is in the fifo, so the end of
+// transmission interrupt is used to detect when the bus has drained
+void spi1Isr()
+{
+    if (!spi1DmaBusy)
+        return;
+    if (isUdmaChannelInterrupt(SSI1_TX_DMA_CHANNEL))
+    {
+        clearUdmaChannelInterrupt(SSI1_TX_DMA_CHANNEL);
+        SSI1_DMACTL_R &= ~SSI_DMACTL_TXDMAE;
+        if (!spi1DmaRx)
+            SSI1_IM_R |= SSI_IM_TXIM;                  // wait for end of transmission
+    }
+    if (isUdmaChannelInterrupt(SSI1_RX_DMA_CHANNEL))
+    {
+        clearUdmaChannelInterrupt(SSI1_RX_DMA_CHANNEL);
+        SSI1_DMACTL_R &= ~SSI_DMACTL_RXDMAE;
+        startSpi1Segment();                            // all data received, so complete
+    }
+    if (SSI1_MIS_R & SSI_MIS_TXMIS)
+    {
+        SSI1_IM_R &= ~SSI_IM_TXIM;
+        startSpi1Segment();
+    }
+}
@@ -23,9 +23,24 @@
 #ifndef SPI1_H_
 #define SPI1_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #define USE_SSI_FSS 1
 #define USE_SSI_RX  2
 
+#define SPI1_FIFO_DEPTH 8
+
+typedef void (*SPI1_CALLBACK)(void);
+
+// uDMA write segment
+typedef struct _SPI1_SEGMENT
+{
+    const uint8_t* data;
+    uint16_t size;
+    SPI1_CALLBACK before;                              // called with the bus idle, or 0
+} SPI1_SEGMENT;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -34,6 +49,16 @@ void initSpi1(uint32_t pinMask);
 void setSpi1BaudRate(uint32_t clockRate, uint32_t fcyc);
 void setSpi1Mode(uint8_t polarity, uint8_t phase);
 void writeSpi1Data(uint32_t data);
+void putSpi1Data(uint32_t data);
+void waitSpi1Idle();
 uint32_t readSpi1Data();
+void writeSpi1Block(const uint8_t data[], uint16_t size);
+void transferSpi1Block(const uint8_t txData[], uint8_t rxData[], uint16_t size);
+void initSpi1Dma();
+bool writeSpi1Dma(const uint8_t data[], uint16_t size, SPI1_CALLBACK callback);
+bool writeSpi1DmaSegments(const SPI1_SEGMENT segments[], uint8_t count, SPI1_CALLBACK callback);
+bool transferSpi1Dma(const uint8_t txData[], uint8_t rxData[], uint16_t size, SPI1_CALLBACK callback);
+bool isSpi1DmaBusy();
+void spi1Isr();
 
 #endif
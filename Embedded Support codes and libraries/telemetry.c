@@ -0,0 +1,127 @@
+// Telemetry Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// UART Interface:
+//   U0TX (PA1) and U0RX (PA0) are connected to the 2nd controller
+//   The USB on the 2nd controller enumerates to an ICDI interface and a virtual COM port
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "telemetry.h"
+#include "cobs.h"
+#include "uart0.h"
+
+#define MAX_FRAME (2 + TELEMETRY_MAX_PAYLOAD + 2)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+uint8_t telemetrySequence = 0;
+uint32_t telemetryDropCount = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Non-blocking function that queues a frame in the UART0 tx ring buffer
+// Frames that do not fit are dropped whole; the host sees the sequence gap
+bool sendTelemetryFrame(uint8_t type, const uint8_t payload[], uint8_t size)
+{
+    uint8_t frame[MAX_FRAME];
+    uint8_t encoded[COBS_MAX_ENCODED_SIZE(MAX_FRAME) + 1];
+    uint16_t crc, length;
+    uint8_t i;
+
+    if (size > TELEMETRY_MAX_PAYLOAD)
+        return false;
+
+    // build frame
+    frame[0] = type;
+    frame[1] = telemetrySequence++;
+    for (i = 0; i < size; i++)
+        frame[2 + i] = payload[i];
+    crc = calculateCrc16(frame, size + 2);
+    frame[size + 2] = crc & 0xFF;
+    frame[size + 3] = crc >> 8;
+
+    // encode and delimit
+    length = encodeCobs(frame, size + 4, encoded);
+    encoded[length++] = COBS_DELIMITER;
+
+    if (getUart0TxFree() < length)
+    {
+        telemetryDropCount++;
+        return false;
+    }
+    writeUart0((char*)encoded, length);
+    return true;
+}
+
+// Little endian field packing
+uint8_t* packTelemetry16(uint8_t* p, uint16_t value)
+{
+    *p++ = value & 0xFF;
+    *p++ = value >> 8;
+    return p;
+}
+
+uint8_t* packTelemetry32(uint8_t* p, uint32_t value)
+{
+    p = packTelemetry16(p, value & 0xFFFF);
+    return packTelemetry16(p, value >> 16);
+}
+
+bool sendTelemetryPidSample(uint32_t time, int16_t y, int16_t u, int16_t setPoint)
+{
+    uint8_t payload[10];
+    uint8_t* p = packTelemetry32(payload, time);
+    p = packTelemetry16(p, y);
+    p = packTelemetry16(p, u);
+    packTelemetry16(p, setPoint);
+    return sendTelemetryFrame(TELEMETRY_PID_SAMPLE, payload, sizeof(payload));
+}
+
+bool sendTelemetryAdcReading(uint32_t time, uint8_t channel, uint16_t raw)
+{
+    uint8_t payload[7];
+    uint8_t* p = packTelemetry32(payload, time);
+    *p++ = channel;
+    packTelemetry16(p, raw);
+    return sendTelemetryFrame(TELEMETRY_ADC_READING, payload, sizeof(payload));
+}
+
+bool sendTelemetryQeiPosition(uint32_t time, int32_t position)
+{
+    uint8_t payload[8];
+    uint8_t* p = packTelemetry32(payload, time);
+    packTelemetry32(p, position);
+    return sendTelemetryFrame(TELEMETRY_QEI_POSITION, payload, sizeof(payload));
+}
+
+// Text messages travel in the same stream as records
+bool sendTelemetryText(const char str[])
+{
+    uint8_t size = 0;
+    while ((size < TELEMETRY_MAX_PAYLOAD) && (str[size] != '\0'))
+        size++;
+    return sendTelemetryFrame(TELEMETRY_TEXT, (const uint8_t*)str, size);
+}
+
+uint32_t getTelemetryDropCount()
+{
+    return telemetryDropCount;
+}
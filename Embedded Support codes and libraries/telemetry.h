@@ -0,0 +1,56 @@
+// Telemetry Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// UART Interface:
+//   U0TX (PA1) and U0RX (PA0) are connected to the 2nd controller
+//   The USB on the 2nd controller enumerates to an ICDI interface and a virtual COM port
+
+// Binary telemetry frames sent over UART0
+// Frame before encoding (multi-byte fields are little endian):
+//   type (1) | sequence (1) | payload (0-64) | crc16 (2, over type through payload)
+// Each frame is COBS encoded and followed by a 0x00 delimiter
+// Payloads:
+//   TELEMETRY_PID_SAMPLE:   time (u32, ms) | y (i16) | u (i16) | set point (i16)
+//   TELEMETRY_ADC_READING:  time (u32, ms) | channel (u8) | raw (u16)
+//   TELEMETRY_QEI_POSITION: time (u32, ms) | position (i32)
+//   TELEMETRY_TEXT:         characters (no null)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Record types
+#define TELEMETRY_PID_SAMPLE   1
+#define TELEMETRY_ADC_READING  2
+#define TELEMETRY_QEI_POSITION 3
+#define TELEMETRY_TEXT         4
+
+#define TELEMETRY_MAX_PAYLOAD  64
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+bool sendTelemetryFrame(uint8_t type, const uint8_t payload[], uint8_t size);
+bool sendTelemetryPidSample(uint32_t time, int16_t y, int16_t u, int16_t setPoint);
+bool sendTelemetryAdcReading(uint32_t time, uint8_t channel, uint16_t raw);
+bool sendTelemetryQeiPosition(uint32_t time, int32_t position);
+bool sendTelemetryText(const char str[]);
+uint32_t getTelemetryDropCount();
+
+#endif
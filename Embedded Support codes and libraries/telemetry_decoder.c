@@ -0,0 +1,197 @@
+// Telemetry Decoder (host)
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Linux PC
+// Target uC:       -
+// System Clock:    -
+
+// Hardware configuration:
+// Serial port or pty carrying the COBS framed stream from telemetry.c
+
+// Build: gcc -O2 -o telemetry_decoder telemetry_decoder.c cobs.c
+// Usage: telemetry_decoder /dev/ttyACM0 [baud] > samples.csv
+// Writes one CSV line per record to stdout (first column is the record type)
+// Reports sequence gaps and crc errors to stderr
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>          // EXIT_ codes, atoi
+#include <stdio.h>           // printf
+#include <stdint.h>          // C99 integer types
+#include <stdbool.h>         // bool
+#include <fcntl.h>           // open
+#include <termios.h>         // tcgetattr, cfmakeraw
+#include <unistd.h>          // read, close
+#include "cobs.h"
+#include "telemetry.h"
+
+#define MAX_ENCODED 256
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+uint32_t frameCount = 0;
+uint32_t crcErrorCount = 0;
+uint32_t framingErrorCount = 0;
+uint32_t lostFrameCount = 0;
+bool sequenceValid = false;
+uint8_t lastSequence;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+speed_t getSpeed(int baud)
+{
+    switch (baud)
+    {
+        case 9600:   return B9600;
+        case 19200:  return B19200;
+        case 38400:  return B38400;
+        case 57600:  return B57600;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default:     return B115200;
+    }
+}
+
+// Opens a tty in raw mode; a pty or non-tty file is used as is
+int openPort(const char name[], int baud)
+{
+    struct termios tio;
+    int file = open(name, O_RDONLY | O_NOCTTY);
+    if (file >= 0 && tcgetattr(file, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, getSpeed(baud));
+        cfsetospeed(&tio, getSpeed(baud));
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(file, TCSANOW, &tio);
+    }
+    return file;
+}
+
+uint16_t get16(const uint8_t* p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+uint32_t get32(const uint8_t* p)
+{
+    return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+void processFrame(const uint8_t encoded[], uint16_t size)
+{
+    uint8_t frame[MAX_ENCODED];
+    const uint8_t* payload = frame + 2;
+    uint16_t length, payloadSize;
+    uint8_t gap;
+
+    length = decodeCobs(encoded, size, frame);
+    if (length < 4)
+    {
+        framingErrorCount++;
+        fprintf(stderr, "framing error (%u bytes)\n", size);
+        return;
+    }
+    payloadSize = length - 4;
+    if (calculateCrc16(frame, length - 2) != get16(frame + length - 2))
+    {
+        crcErrorCount++;
+        fprintf(stderr, "crc error (type %u, seq %u)\n", frame[0], frame[1]);
+        return;
+    }
+
+    frameCount++;
+    if (sequenceValid)
+    {
+        gap = frame[1] - (uint8_t)(lastSequence + 1);
+        if (gap != 0)
+        {
+            lostFrameCount += gap;
+            fprintf(stderr, "sequence gap: %u frame(s) lost before seq %u\n", gap, frame[1]);
+        }
+    }
+    lastSequence = frame[1];
+    sequenceValid = true;
+
+    switch (frame[0])
+    {
+        case TELEMETRY_PID_SAMPLE:
+            if (payloadSize == 10)
+                printf("pid,%u,%d,%d,%d\n", get32(payload), (int16_t)get16(payload + 4),
+                       (int16_t)get16(payload + 6), (int16_t)get16(payload + 8));
+            break;
+        case TELEMETRY_ADC_READING:
+            if (payloadSize == 7)
+                printf("adc,%u,%u,%u\n", get32(payload), payload[4], get16(payload + 5));
+            break;
+        case TELEMETRY_QEI_POSITION:
+            if (payloadSize == 8)
+                printf("qei,%u,%d\n", get32(payload), (int32_t)get32(payload + 4));
+            break;
+        case TELEMETRY_TEXT:
+            fprintf(stderr, "text: %.*s\n", payloadSize, (const char*)payload);
+            break;
+        default:
+            fprintf(stderr, "unknown type %u\n", frame[0]);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint8_t buffer[256];
+    uint8_t encoded[MAX_ENCODED];
+    uint16_t count = 0;
+    bool overflow = false;
+    ssize_t n, i;
+    int file;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s DEVICE [BAUD]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    file = openPort(argv[1], (argc > 2) ? atoi(argv[2]) : 115200);
+    if (file < 0)
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    // Resynchronize on the first delimiter; a partial first frame is discarded
+    overflow = true;
+    while ((n = read(file, buffer, sizeof(buffer))) > 0)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if (buffer[i] == COBS_DELIMITER)
+            {
+                if (!overflow && count > 0)
+                    processFrame(encoded, count);
+                count = 0;
+                overflow = false;
+            }
+            else if (count < MAX_ENCODED)
+                encoded[count++] = buffer[i];
+            else
+                overflow = true;
+        }
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%u frames, %u lost, %u crc errors, %u framing errors\n",
+            frameCount, lostFrameCount, crcErrorCount, framingErrorCount);
+    close(file);
+    return EXIT_SUCCESS;
+}
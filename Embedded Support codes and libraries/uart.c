@@ -0,0 +1,533 @@
+// UART Library
+// Jason Losh
+
+// Hook in uartNIsr to the UARTN IVT entry of each UART used
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// UART Interfaces (RX, TX):
+//   UART0 on PA0, PA1 (connected to the ICDI virtual COM port)
+//   UART1 on PB0, PB1
+//   UART2 on PD6, PD7
+//   UART3 on PC6, PC7
+//   UART4 on PC4, PC5
+//   UART5 on PE4, PE5
+//   UART6 on PD4, PD5
+//   UART7 on PE0, PE1
+// uDMA transmit channels (channel/encoding):
+//   UART0 9/0, UART1 23/0, UART2 1/1, UART3 17/2, UART4 19/2, UART5 7/2,
+//   UART6 11/2, UART7 21/2
+//   Channels are shared with other peripherals under other encodings (for example,
+//   channel 11 is SSI0 TX and channel 17 is ADC0 SS3), so only one user of a
+//   channel can be active at a time
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "uart.h"
+#include "gpio.h"
+#include "nvic.h"
+#include "udma.h"
+
+// Register access relative to the module base address
+#define UART_DR(b)      (*((volatile uint32_t *)((b) + 0x000)))
+#define UART_FR(b)      (*((volatile uint32_t *)((b) + 0x018)))
+#define UART_IBRD(b)    (*((volatile uint32_t *)((b) + 0x024)))
+#define UART_FBRD(b)    (*((volatile uint32_t *)((b) + 0x028)))
+#define UART_LCRH(b)    (*((volatile uint32_t *)((b) + 0x02C)))
+#define UART_CTL(b)     (*((volatile uint32_t *)((b) + 0x030)))
+#define UART_IFLS(b)    (*((volatile uint32_t *)((b) + 0x034)))
+#define UART_IM(b)      (*((volatile uint32_t *)((b) + 0x038)))
+#define UART_MIS(b)     (*((volatile uint32_t *)((b) + 0x040)))
+#define UART_ICR(b)     (*((volatile uint32_t *)((b) + 0x044)))
+#define UART_DMACTL(b)  (*((volatile uint32_t *)((b) + 0x048)))
+#define UART_CC(b)      (*((volatile uint32_t *)((b) + 0xFC8)))
+
+#define UART_TX_DMA_CONTROL (UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_8 | \
+                             UDMA_CHCTL_SRCINC_8 | UDMA_CHCTL_SRCSIZE_8 | \
+                             UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERMODE_PINGPONG)
+
+// Fixed hardware description of each module
+typedef struct _UART_DESCRIPTOR
+{
+    uint32_t base;
+    uint32_t clockMask;
+    PORT port;
+    uint8_t rxPin;
+    uint8_t txPin;
+    uint8_t pinFunction;
+    uint8_t vector;
+    uint8_t txDmaChannel;
+    uint8_t txDmaEncoding;
+} UART_DESCRIPTOR;
+
+// Run-time state of each module
+typedef struct _UART_STATE
+{
+    // Transmit ring buffer (written by the application, read by the isr)
+    char* txBuffer;
+    uint16_t txMask;
+    volatile uint16_t txWriteIndex;
+    volatile uint16_t txReadIndex;
+    // Receive ring buffer (written by the isr, read by the application)
+    char* rxBuffer;
+    uint16_t rxMask;
+    volatile uint16_t rxWriteIndex;
+    volatile uint16_t rxReadIndex;
+    UART_CALLBACK txEmptyCallback;
+    UART_CALLBACK rxLineCallback;
+    volatile UART_STATS stats;
+    // DMA transmit state
+    // Up to two buffers are loaded (primary and alternate structures), used in ping-pong order
+    // Ring buffer bytes queued before a DMA request are sent first, up to txDmaIndex
+    const char* dmaBuffer[2];
+    volatile uint8_t dmaQueued;
+    volatile uint8_t dmaActive;
+    volatile bool dmaRunning;
+    volatile uint16_t txDmaIndex;
+    UART_DMA_CALLBACK dmaCallback;
+} UART_STATE;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const UART_DESCRIPTOR uartDescriptor[UART_COUNT] =
+{
+    {0x4000C000, SYSCTL_RCGCUART_R0, PORTA, 0, 1, 1, INT_UART0, 9, 0},
+    {0x4000D000, SYSCTL_RCGCUART_R1, PORTB, 0, 1, 1, INT_UART1, 23, 0},
+    {0x4000E000, SYSCTL_RCGCUART_R2, PORTD, 6, 7, 1, INT_UART2, 1, 1},
+    {0x4000F000, SYSCTL_RCGCUART_R3, PORTC, 6, 7, 1, INT_UART3, 17, 2},
+    {0x40010000, SYSCTL_RCGCUART_R4, PORTC, 4, 5, 1, INT_UART4, 19, 2},
+    {0x40011000, SYSCTL_RCGCUART_R5, PORTE, 4, 5, 1, INT_UART5, 7, 2},
+    {0x40012000, SYSCTL_RCGCUART_R6, PORTD, 4, 5, 1, INT_UART6, 11, 2},
+    {0x40013000, SYSCTL_RCGCUART_R7, PORTE, 0, 1, 1, INT_UART7, 21, 2}
+};
+
+UART_STATE uartState[UART_COUNT];
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Initialize UART
+// Returns false if the uart does not exist or a ring buffer size is not a power of 2
+bool initUart(uint8_t uart, char txBuffer[], uint16_t txSize, char rxBuffer[], uint16_t rxSize)
+{
+    const UART_DESCRIPTOR* d = &uartDescriptor[uart];
+    UART_STATE* s = &uartState[uart];
+    if (uart >= UART_COUNT || txSize == 0 || (txSize & (txSize - 1)) != 0
+        || rxSize == 0 || (rxSize & (rxSize - 1)) != 0)
+        return false;
+
+    // Enable clocks
+    SYSCTL_RCGCUART_R |= d->clockMask;
+    _delay_cycles(3);
+    enablePort(d->port);
+
+    // Configure UART pins
+    if ((d->port == PORTD) && (d->txPin == 7))
+        setPinCommitControl(d->port, d->txPin);         // unlock PD7 (NMI)
+    selectPinPushPullOutput(d->port, d->txPin);
+    selectPinDigitalInput(d->port, d->rxPin);
+    setPinAuxFunction(d->port, d->txPin, d->pinFunction);
+    setPinAuxFunction(d->port, d->rxPin, d->pinFunction);
+
+    // Configure UART with default baud rate
+    UART_CTL(d->base) = 0;                              // turn-off UART to allow safe programming
+    UART_CC(d->base) = UART_CC_CS_SYSCLK;               // use system clock (usually 40 MHz)
+
+    // Attach ring buffers
+    s->txBuffer = txBuffer;
+    s->txMask = txSize - 1;
+    s->txWriteIndex = s->txReadIndex = 0;
+    s->rxBuffer = rxBuffer;
+    s->rxMask = rxSize - 1;
+    s->rxWriteIndex = s->rxReadIndex = 0;
+    s->txEmptyCallback = 0;
+    s->rxLineCallback = 0;
+    s->dmaQueued = 0;
+    s->dmaActive = 0;
+    s->dmaRunning = false;
+    s->dmaCallback = 0;
+    clearUartStats(uart);
+
+    // Configure interrupts
+    UART_IFLS(d->base) = UART_IFLS_TX4_8 | UART_IFLS_RX4_8;
+                                                        // interrupt at half-full fifo levels
+    UART_ICR(d->base) = 0xFFFFFFFF;                     // clear any stale interrupts
+    UART_IM(d->base) = UART_IM_RXIM | UART_IM_RTIM | UART_IM_OEIM;
+                                                        // rx interrupts always on, tx on demand
+    enableNvicInterrupt(d->vector);
+    return true;
+}
+
+// Set baud rate as function of instruction cycle frequency
+void setUartBaudRate(uint8_t uart, uint32_t baudRate, uint32_t fcyc)
+{
+    uint32_t base = uartDescriptor[uart].base;
+    uint32_t divisorTimes128 = (fcyc * 8) / baudRate;   // calculate divisor (r) in units of 1/128,
+                                                        // where r = fcyc / 16 * baudRate
+    divisorTimes128 += 1;                               // add 1/128 to allow rounding
+    UART_CTL(base) = 0;                                 // turn-off UART to allow safe programming
+    UART_IBRD(base) = divisorTimes128 >> 7;             // set integer value to floor(r)
+    UART_FBRD(base) = ((divisorTimes128) >> 1) & 63;    // set fractional value to round(fract(r)*64)
+    UART_LCRH(base) = UART_LCRH_WLEN_8 | UART_LCRH_FEN; // configure for 8N1 w/ 16-level FIFO
+    UART_CTL(base) = UART_CTL_TXE | UART_CTL_RXE | UART_CTL_UARTEN;
+                                                        // turn-on UART
+}
+
+// Starts the dma channel on the active structure
+void startUartDma(uint8_t uart)
+{
+    const UART_DESCRIPTOR* d = &uartDescriptor[uart];
+    UART_STATE* s = &uartState[uart];
+    selectUdmaChannelStructure(d->txDmaChannel, s->dmaActive);
+    enableUdmaChannel(d->txDmaChannel);
+    UART_DMACTL(d->base) |= UART_DMACTL_TXDMAE;
+    s->dmaRunning = true;
+}
+
+// Moves data from the tx ring buffer into the hardware fifo
+// Called from the isr or with the tx interrupt masked
+// Returns true once all ring buffer data ahead of any dma request is in the fifo
+bool fillUartTxFifo(uint8_t uart)
+{
+    uint32_t base = uartDescriptor[uart].base;
+    UART_STATE* s = &uartState[uart];
+    uint16_t readIndex = s->txReadIndex;
+    uint16_t endIndex = s->dmaQueued ? s->txDmaIndex : s->txWriteIndex;
+    while ((readIndex != endIndex) && !(UART_FR(base) & UART_FR_TXFF))
+    {
+        UART_DR(base) = s->txBuffer[readIndex];
+        readIndex = (readIndex + 1) & s->txMask;
+    }
+    s->txReadIndex = readIndex;
+    return readIndex == endIndex;
+}
+
+// Primes the hardware fifo and arms the tx interrupt if data remains queued
+void startUartTx(uint8_t uart)
+{
+    uint32_t base = uartDescriptor[uart].base;
+    UART_STATE* s = &uartState[uart];
+    UART_IM(base) &= ~UART_IM_TXIM;                     // keep isr away from the read index
+    if (s->dmaRunning)                                  // ring data waits behind the dma transfer
+        return;
+    if (fillUartTxFifo(uart))
+    {
+        if (s->dmaQueued)
+            startUartDma(uart);
+    }
+    else
+        UART_IM(base) |= UART_IM_TXIM;                  // isr refills as fifo drains
+}
+
+// Returns the number of bytes that can be queued without blocking
+uint16_t getUartTxFree(uint8_t uart)
+{
+    UART_STATE* s = &uartState[uart];
+    return (s->txReadIndex - s->txWriteIndex - 1) & s->txMask;
+}
+
+// Returns the number of received bytes waiting in the rx ring buffer
+uint16_t getUartRxCount(uint8_t uart)
+{
+    UART_STATE* s = &uartState[uart];
+    return (s->rxWriteIndex - s->rxReadIndex) & s->rxMask;
+}
+
+// Copies data into the tx ring buffer, updating the high-water mark
+void queueUartTx(uint8_t uart, const char data[], uint16_t size)
+{
+    UART_STATE* s = &uartState[uart];
+    uint16_t i;
+    uint16_t writeIndex = s->txWriteIndex;
+    uint16_t count;
+    for (i = 0; i < size; i++)
+    {
+        s->txBuffer[writeIndex] = data[i];
+        writeIndex = (writeIndex + 1) & s->txMask;
+    }
+    s->txWriteIndex = writeIndex;
+    count = (writeIndex - s->txReadIndex) & s->txMask;
+    if (count > s->stats.txHighWater)
+        s->stats.txHighWater = count;
+}
+
+// Non-blocking function that queues as much data as fits and returns the number of bytes queued
+uint16_t writeUart(uint8_t uart, const char data[], uint16_t size)
+{
+    uint16_t count = getUartTxFree(uart);
+    if (count > size)
+        count = size;
+    uartState[uart].stats.txDropCount += size - count;
+    queueUartTx(uart, data, count);
+    startUartTx(uart);
+    return count;
+}
+
+// Non-blocking function that returns up to size received bytes
+uint16_t readUart(uint8_t uart, char data[], uint16_t size)
+{
+    UART_STATE* s = &uartState[uart];
+    uint16_t count = 0;
+    uint16_t readIndex = s->rxReadIndex;
+    while ((count < size) && (readIndex != s->rxWriteIndex))
+    {
+        data[count++] = s->rxBuffer[readIndex];
+        readIndex = (readIndex + 1) & s->rxMask;
+    }
+    s->rxReadIndex = readIndex;
+    return count;
+}
+
+// Non-blocking function that streams a buffer of 1-1024 bytes using the uDMA controller
+// Two buffers can be pending at once; the second is chained in ping-pong order so
+// the stream is continuous. Returns false if both slots are in use.
+// The buffer must remain valid until the dma callback reports it complete.
+// initUdma() must be called before the first transfer.
+bool writeUartDma(uint8_t uart, const char data[], uint16_t size)
+{
+    const UART_DESCRIPTOR* d = &uartDescriptor[uart];
+    UART_STATE* s = &uartState[uart];
+    uint8_t slot;
+    bool ok = false;
+    if ((size == 0) || (size > UDMA_MAX_TRANSFER))
+        return false;
+    disableNvicInterrupt(d->vector);                    // isr also updates the dma state
+    if (s->dmaQueued < 2)
+    {
+        if (s->dmaQueued == 0)
+            selectUdmaChannelEncoding(d->txDmaChannel, d->txDmaEncoding);
+        slot = (s->dmaActive + s->dmaQueued) & 1;
+        s->dmaBuffer[slot] = data;
+        setUdmaChannelTransfer(d->txDmaChannel, slot, data, &UART_DR(d->base),
+                               UART_TX_DMA_CONTROL, size);
+        if (s->dmaQueued++ == 0)
+        {
+            s->txDmaIndex = s->txWriteIndex;            // earlier ring data goes first
+            startUartTx(uart);
+        }
+        ok = true;
+    }
+    enableNvicInterrupt(d->vector);
+    return ok;
+}
+
+// Returns true if a dma transfer is pending or in progress
+bool isUartDmaBusy(uint8_t uart)
+{
+    return uartState[uart].dmaQueued != 0;
+}
+
+// Called from the isr as each dma buffer completes (the buffer can then be reused)
+void setUartDmaCallback(uint8_t uart, UART_DMA_CALLBACK callback)
+{
+    uartState[uart].dmaCallback = callback;
+}
+
+// Retires completed dma buffers and restarts or hands the fifo back to the ring buffer
+void serviceUartDma(uint8_t uart)
+{
+    const UART_DESCRIPTOR* d = &uartDescriptor[uart];
+    UART_STATE* s = &uartState[uart];
+    const char* buffer;
+    clearUdmaChannelInterrupt(d->txDmaChannel);
+    while (s->dmaQueued && isUdmaTransferDone(d->txDmaChannel, s->dmaActive))
+    {
+        buffer = s->dmaBuffer[s->dmaActive];
+        s->dmaActive ^= 1;
+        s->dmaQueued--;
+        if (s->dmaCallback)
+            s->dmaCallback(buffer);
+    }
+    if (!isUdmaChannelEnabled(d->txDmaChannel))
+    {
+        s->dmaRunning = false;
+        if (s->dmaQueued)
+            startUartDma(uart);                         // next buffer was chained after the stop
+        else
+        {
+            UART_DMACTL(d->base) &= ~UART_DMACTL_TXDMAE;
+            startUartTx(uart);                          // resume ring buffer output
+        }
+    }
+}
+
+// Blocking function that writes a serial character when the UART buffer is not full
+void putcUart(uint8_t uart, char c)
+{
+    while (getUartTxFree(uart) == 0);                   // wait if tx ring buffer full
+    queueUartTx(uart, &c, 1);
+    startUartTx(uart);
+}
+
+// Blocking function that writes a string when the UART buffer is not full
+void putsUart(uint8_t uart, char* str)
+{
+    uint16_t free, count;
+    // queue the string in runs that fit, only blocking while the ring buffer is full
+    while (*str != '\0')
+    {
+        while ((free = getUartTxFree(uart)) == 0);
+        count = 0;
+        while ((count < free) && (str[count] != '\0'))
+            count++;
+        queueUartTx(uart, str, count);
+        startUartTx(uart);
+        str += count;
+    }
+}
+
+// Blocking function that returns with serial data once the buffer is not empty
+char getcUart(uint8_t uart)
+{
+    UART_STATE* s = &uartState[uart];
+    char c;
+    while (s->rxReadIndex == s->rxWriteIndex);          // wait if rx ring buffer empty
+    c = s->rxBuffer[s->rxReadIndex];
+    s->rxReadIndex = (s->rxReadIndex + 1) & s->rxMask;
+    return c;
+}
+
+// Returns the status of the receive buffer
+bool kbhitUart(uint8_t uart)
+{
+    return uartState[uart].rxReadIndex != uartState[uart].rxWriteIndex;
+}
+
+// Called from the isr each time the tx ring buffer empties
+void setUartTxEmptyCallback(uint8_t uart, UART_CALLBACK callback)
+{
+    uartState[uart].txEmptyCallback = callback;
+}
+
+// Called from the isr each time a carriage return or line feed is received
+void setUartRxLineCallback(uint8_t uart, UART_CALLBACK callback)
+{
+    uartState[uart].rxLineCallback = callback;
+}
+
+void getUartStats(uint8_t uart, UART_STATS* stats)
+{
+    *stats = uartState[uart].stats;
+}
+
+void clearUartStats(uint8_t uart)
+{
+    volatile UART_STATS* stats = &uartState[uart].stats;
+    stats->txDropCount = 0;
+    stats->rxDropCount = 0;
+    stats->rxOverrunCount = 0;
+    stats->txHighWater = 0;
+    stats->rxHighWater = 0;
+}
+
+// Common interrupt service for all UARTs
+void serviceUartInterrupt(uint8_t uart)
+{
+    const UART_DESCRIPTOR* d = &uartDescriptor[uart];
+    UART_STATE* s = &uartState[uart];
+    uint32_t status = UART_MIS(d->base);
+    uint32_t data;
+    uint16_t nextIndex;
+    uint16_t count;
+    bool line = false;
+
+    // drain rx fifo into the rx ring buffer
+    if (status & (UART_MIS_RXMIS | UART_MIS_RTMIS | UART_MIS_OEMIS))
+    {
+        UART_ICR(d->base) = UART_ICR_RXIC | UART_ICR_RTIC | UART_ICR_OEIC;
+        while (!(UART_FR(d->base) & UART_FR_RXFE))
+        {
+            data = UART_DR(d->base);
+            if (data & UART_DR_OE)
+                s->stats.rxOverrunCount++;
+            nextIndex = (s->rxWriteIndex + 1) & s->rxMask;
+            if (nextIndex == s->rxReadIndex)
+                s->stats.rxDropCount++;
+            else
+            {
+                s->rxBuffer[s->rxWriteIndex] = data & 0xFF;
+                s->rxWriteIndex = nextIndex;
+            }
+            line |= ((data & 0xFF) == '\r') || ((data & 0xFF) == '\n');
+        }
+        count = getUartRxCount(uart);
+        if (count > s->stats.rxHighWater)
+            s->stats.rxHighWater = count;
+        if (line && s->rxLineCallback)
+            s->rxLineCallback();
+    }
+
+    // refill tx fifo from the tx ring buffer
+    if (status & UART_MIS_TXMIS)
+    {
+        UART_ICR(d->base) = UART_ICR_TXIC;
+        if (fillUartTxFifo(uart))
+        {
+            UART_IM(d->base) &= ~UART_IM_TXIM;
+            if (s->dmaQueued)
+                startUartDma(uart);
+            else if (s->txEmptyCallback)
+                s->txEmptyCallback();
+        }
+    }
+
+    // dma completion is signaled on the uart vector
+    if (s->dmaRunning && isUdmaChannelInterrupt(d->txDmaChannel))
+        serviceUartDma(uart);
+}
+
+// UART interrupts
+void uart0Isr()
+{
+    serviceUartInterrupt(0);
+}
+
+void uart1Isr()
+{
+    serviceUartInterrupt(1);
+}
+
+void uart2Isr()
+{
+    serviceUartInterrupt(2);
+}
+
+void uart3Isr()
+{
+    serviceUartInterrupt(3);
+}
+
+void uart4Isr()
+{
+    serviceUartInterrupt(4);
+}
+
+void uart5Isr()
+{
+    serviceUartInterrupt(5);
+}
+
+void uart6Isr()
+{
+    serviceUartInterrupt(6);
+}
+
+void uart7Isr()
+{
+    serviceUartInterrupt(7);
+}
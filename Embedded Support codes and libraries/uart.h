@@ -0,0 +1,81 @@
+// UART Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// UART Interfaces (RX, TX):
+//   UART0 on PA0, PA1 (connected to the ICDI virtual COM port)
+//   UART1 on PB0, PB1
+//   UART2 on PD6, PD7
+//   UART3 on PC6, PC7
+//   UART4 on PC4, PC5
+//   UART5 on PE4, PE5
+//   UART6 on PD4, PD5
+//   UART7 on PE0, PE1
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef UART_H_
+#define UART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UART_COUNT 8
+
+typedef struct _UART_STATS
+{
+    uint32_t txDropCount;        // bytes rejected by non-blocking writes (tx ring full)
+    uint32_t rxDropCount;        // bytes discarded by the isr (rx ring full)
+    uint32_t rxOverrunCount;     // bytes lost in the hardware fifo
+    uint16_t txHighWater;        // maximum tx ring occupancy
+    uint16_t rxHighWater;        // maximum rx ring occupancy
+} UART_STATS;
+
+typedef void (*UART_CALLBACK)(void);
+typedef void (*UART_DMA_CALLBACK)(const char data[]);
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Ring buffer sizes must be powers of 2
+bool initUart(uint8_t uart, char txBuffer[], uint16_t txSize, char rxBuffer[], uint16_t rxSize);
+void setUartBaudRate(uint8_t uart, uint32_t baudRate, uint32_t fcyc);
+void putcUart(uint8_t uart, char c);
+void putsUart(uint8_t uart, char* str);
+char getcUart(uint8_t uart);
+bool kbhitUart(uint8_t uart);
+
+uint16_t writeUart(uint8_t uart, const char data[], uint16_t size);
+uint16_t readUart(uint8_t uart, char data[], uint16_t size);
+uint16_t getUartTxFree(uint8_t uart);
+uint16_t getUartRxCount(uint8_t uart);
+void setUartTxEmptyCallback(uint8_t uart, UART_CALLBACK callback);
+void setUartRxLineCallback(uint8_t uart, UART_CALLBACK callback);
+void getUartStats(uint8_t uart, UART_STATS* stats);
+void clearUartStats(uint8_t uart);
+
+bool writeUartDma(uint8_t uart, const char data[], uint16_t size);
+bool isUartDmaBusy(uint8_t uart);
+void setUartDmaCallback(uint8_t uart, UART_DMA_CALLBACK callback);
+
+void uart0Isr();
+void uart1Isr();
+void uart2Isr();
+void uart3Isr();
+void uart4Isr();
+void uart5Isr();
+void uart6Isr();
+void uart7Isr();
+
+#endif
@@ -1,6 +1,9 @@
 // UART0 Library
 // Jason Losh
 
+// UART0 instance of the UART library (uart.c)
+// Hook in uart0Isr to UART0 IVT entry
+
 //-----------------------------------------------------------------------------
 // Hardware Target
 //-----------------------------------------------------------------------------
@@ -20,18 +23,16 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "tm4c123gh6pm.h"
+#include "uart.h"
 #include "uart0.h"
-#include "gpio.h"
-
-// Pins
-#define UART_TX PORTA,1
-#define UART_RX PORTA,0
 
 //-----------------------------------------------------------------------------
 // Global variables
 //-----------------------------------------------------------------------------
 
+char uart0TxBuffer[UART0_TX_BUFFER_SIZE];
+char uart0RxBuffer[UART0_RX_BUFFER_SIZE];
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -39,60 +40,93 @@
 // Initialize UART0
 void initUart0(void)
 {
-    // Enable clocks
-    SYSCTL_RCGCUART_R |= SYSCTL_RCGCUART_R0;
-    _delay_cycles(3);
-    enablePort(PORTA);
-
-    // Configure UART0 pins
-    selectPinPushPullOutput(UART_TX);
-    selectPinDigitalInput(UART_RX);
-    setPinAuxFunction(UART_TX, GPIO_PCTL_PA1_U0TX);
-    setPinAuxFunction(UART_RX, GPIO_PCTL_PA0_U0RX);
-
-    // Configure UART0 with default baud rate
-    UART0_CTL_R = 0;                                    // turn-off UART0 to allow safe programming
-    UART0_CC_R = UART_CC_CS_SYSCLK;                     // use system clock (usually 40 MHz)
+    initUart(0, uart0TxBuffer, UART0_TX_BUFFER_SIZE, uart0RxBuffer, UART0_RX_BUFFER_SIZE);
 }
 
 // Set baud rate as function of instruction cycle frequency
 void setUart0BaudRate(uint32_t baudRate, uint32_t fcyc)
 {
-    uint32_t divisorTimes128 = (fcyc * 8) / baudRate;   // calculate divisor (r) in units of 1/128,
-                                                        // where r = fcyc / 16 * baudRate
-    divisorTimes128 += 1;                               // add 1/128 to allow rounding
-    UART0_CTL_R = 0;                                    // turn-off UART0 to allow safe programming
-    UART0_IBRD_R = divisorTimes128 >> 7;                // set integer value to floor(r)
-    UART0_FBRD_R = ((divisorTimes128) >> 1) & 63;       // set fractional value to round(fract(r)*64)
-    UART0_LCRH_R = UART_LCRH_WLEN_8 | UART_LCRH_FEN;    // configure for 8N1 w/ 16-level FIFO
-    UART0_CTL_R = UART_CTL_TXE | UART_CTL_RXE | UART_CTL_UARTEN;
-                                                        // turn-on UART0
+    setUartBaudRate(0, baudRate, fcyc);
 }
 
 // Blocking function that writes a serial character when the UART buffer is not full
 void putcUart0(char c)
 {
-    while (UART0_FR_R & UART_FR_TXFF);               // wait if uart0 tx fifo full
-    UART0_DR_R = c;                                  // write character to fifo
+    putcUart(0, c);
 }
 
 // Blocking function that writes a string when the UART buffer is not full
 void putsUart0(char* str)
 {
-    uint8_t i = 0;
-    while (str[i] != '\0')
-        putcUart0(str[i++]);
+    putsUart(0, str);
 }
 
 // Blocking function that returns with serial data once the buffer is not empty
 char getcUart0(void)
 {
-    while (UART0_FR_R & UART_FR_RXFE);               // wait if uart0 rx fifo empty
-    return UART0_DR_R & 0xFF;                        // get character from fifo
+    return getcUart(0);
 }
 
 // Returns the status of the receive buffer
 bool kbhitUart0(void)
 {
-    return !(UART0_FR_R & UART_FR_RXFE);
+    return kbhitUart(0);
+}
+
+// Non-blocking function that queues as much data as fits and returns the number of bytes queued
+uint16_t writeUart0(const char data[], uint16_t size)
+{
+    return writeUart(0, data, size);
+}
+
+// Non-blocking function that returns up to size received bytes
+uint16_t readUart0(char data[], uint16_t size)
+{
+    return readUart(0, data, size);
+}
+
+uint16_t getUart0TxFree()
+{
+    return getUartTxFree(0);
+}
+
+uint16_t getUart0RxCount()
+{
+    return getUartRxCount(0);
+}
+
+void setUart0TxEmptyCallback(UART0_CALLBACK callback)
+{
+    setUartTxEmptyCallback(0, callback);
+}
+
+void setUart0RxLineCallback(UART0_CALLBACK callback)
+{
+    setUartRxLineCallback(0, callback);
+}
+
+void getUart0Stats(UART0_STATS* stats)
+{
+    getUartStats(0, stats);
+}
+
+void clearUart0Stats()
+{
+    clearUartStats(0);
+}
+
+// Non-blocking function that streams a buffer of 1-1024 bytes using uDMA channel 9
+bool writeUart0Dma(const char data[], uint16_t size)
+{
+    return writeUartDma(0, data, size);
+}
+
+bool isUart0DmaBusy()
+{
+    return isUartDmaBusy(0);
+}
+
+void setUart0DmaCallback(UART0_DMA_CALLBACK callback)
+{
+    setUartDmaCallback(0, callback);
 }
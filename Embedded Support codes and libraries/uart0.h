@@ -21,6 +21,22 @@
 #ifndef UART0_H_
 #define UART0_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart.h"
+
+// Ring buffer sizes (must be powers of 2)
+#ifndef UART0_TX_BUFFER_SIZE
+#define UART0_TX_BUFFER_SIZE 256
+#endif
+#ifndef UART0_RX_BUFFER_SIZE
+#define UART0_RX_BUFFER_SIZE 64
+#endif
+
+typedef UART_STATS UART0_STATS;
+typedef UART_CALLBACK UART0_CALLBACK;
+typedef UART_DMA_CALLBACK UART0_DMA_CALLBACK;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -32,4 +48,17 @@ void putsUart0(char* str);
 char getcUart0();
 bool kbhitUart0();
 
+uint16_t writeUart0(const char data[], uint16_t size);
+uint16_t readUart0(char data[], uint16_t size);
+uint16_t getUart0TxFree();
+uint16_t getUart0RxCount();
+void setUart0TxEmptyCallback(UART0_CALLBACK callback);
+void setUart0RxLineCallback(UART0_CALLBACK callback);
+void getUart0Stats(UART0_STATS* stats);
+void clearUart0Stats();
+
+bool writeUart0Dma(const char data[], uint16_t size);
+bool isUart0DmaBusy();
+void setUart0DmaCallback(UART0_DMA_CALLBACK callback);
+
 #endif
@@ -0,0 +1,152 @@
+// uDMA Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// uDMA controller (32 channels, primary and alternate control structures)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "udma.h"
+
+// Channel control structure (16 bytes each)
+typedef struct _UDMA_CONTROL
+{
+    volatile uint32_t srcEnd;
+    volatile uint32_t dstEnd;
+    volatile uint32_t control;
+    uint32_t unused;
+} UDMA_CONTROL;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Primary structures for channels 0-31 followed by alternate structures
+// The table base must be aligned to 1024 bytes
+#pragma DATA_ALIGN(udmaControlTable, 1024)
+UDMA_CONTROL udmaControlTable[64];
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Initialize uDMA controller
+void initUdma()
+{
+    // Enable clocks
+    SYSCTL_RCGCDMA_R |= SYSCTL_RCGCDMA_R0;
+    _delay_cycles(3);
+
+    // Configure controller
+    UDMA_CFG_R = UDMA_CFG_MASTEN;                      // turn-on controller
+    UDMA_CTLBASE_R = (uint32_t)udmaControlTable;       // set control table base
+}
+
+// Select the peripheral source (0-4) of a channel
+void selectUdmaChannelEncoding(uint8_t channel, uint8_t encoding)
+{
+    volatile uint32_t* p = (uint32_t*) &UDMA_CHMAP0_R;
+    uint32_t shift = (channel & 7) * 4;
+    p += channel >> 3;
+    *p = (*p & ~(0xFu << shift)) | ((uint32_t)encoding << shift);
+}
+
+// Load a control structure with a transfer of count items (1-1024)
+// control combines the UDMA_CHCTL_DSTINC, DSTSIZE, SRCINC, SRCSIZE, ARBSIZE and XFERMODE fields
+void setUdmaChannelTransfer(uint8_t channel, uint8_t select, volatile const void* src,
+                            volatile void* dst, uint32_t control, uint16_t count)
+{
+    UDMA_CONTROL* entry = &udmaControlTable[channel + (select ? 32 : 0)];
+    uint32_t srcInc = (control & UDMA_CHCTL_SRCINC_M) >> 26;
+    uint32_t dstInc = (control & UDMA_CHCTL_DSTINC_M) >> 30;
+
+    // end pointers address the last item (increment of 3 means no increment)
+    entry->srcEnd = (uint32_t)src + ((srcInc == 3) ? 0 : ((uint32_t)(count - 1) << srcInc));
+    entry->dstEnd = (uint32_t)dst + ((dstInc == 3) ? 0 : ((uint32_t)(count - 1) << dstInc));
+    entry->control = (control & ~UDMA_CHCTL_XFERSIZE_M) | ((uint32_t)(count - 1) << 4);
+}
+
+// Allow single requests (false) or only burst requests (true)
+void setUdmaChannelBurstOnly(uint8_t channel, bool burstOnly)
+{
+    if (burstOnly)
+        UDMA_USEBURSTSET_R = 1u << channel;
+    else
+        UDMA_USEBURSTCLR_R = 1u << channel;
+}
+
+// Select which control structure is used at the next request
+void selectUdmaChannelStructure(uint8_t channel, uint8_t select)
+{
+    if (select)
+        UDMA_ALTSET_R = 1u << channel;
+    else
+        UDMA_ALTCLR_R = 1u << channel;
+}
+
+uint8_t getUdmaChannelStructure(uint8_t channel)
+{
+    return (UDMA_ALTSET_R >> channel) & 1;
+}
+
+void enableUdmaChannel(uint8_t channel)
+{
+    UDMA_ENASET_R = 1u << channel;
+}
+
+void disableUdmaChannel(uint8_t channel)
+{
+    UDMA_ENACLR_R = 1u << channel;
+}
+
+// The controller disables a channel once no valid control structure remains
+bool isUdmaChannelEnabled(uint8_t channel)
+{
+    return (UDMA_ENASET_R >> channel) & 1;
+}
+
+// The controller sets the mode of a structure to stop when it completes
+bool isUdmaTransferDone(uint8_t channel, uint8_t select)
+{
+    UDMA_CONTROL* entry = &udmaControlTable[channel + (select ? 32 : 0)];
+    return (entry->control & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP;
+}
+
+// Returns the number of items not yet transferred by a structure
+uint16_t getUdmaTransferRemaining(uint8_t channel, uint8_t select)
+{
+    UDMA_CONTROL* entry = &udmaControlTable[channel + (select ? 32 : 0)];
+    if (isUdmaTransferDone(channel, select))
+        return 0;
+    return ((entry->control & UDMA_CHCTL_XFERSIZE_M) >> 4) + 1;
+}
+
+// Software request (used for memory-to-memory transfers)
+void requestUdmaChannel(uint8_t channel)
+{
+    UDMA_SWREQ_R = 1u << channel;
+}
+
+// Peripheral channel completion is signaled on the peripheral interrupt vector
+bool isUdmaChannelInterrupt(uint8_t channel)
+{
+    return (UDMA_CHIS_R >> channel) & 1;
+}
+
+void clearUdmaChannelInterrupt(uint8_t channel)
+{
+    UDMA_CHIS_R = 1u << channel;
+}
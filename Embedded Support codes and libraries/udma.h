@@ -0,0 +1,52 @@
+// uDMA Library
+// Jason Losh
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+// Hardware configuration:
+// uDMA controller (32 channels, primary and alternate control structures)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef UDMA_H_
+#define UDMA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Control structure select
+#define UDMA_PRIMARY   0
+#define UDMA_ALTERNATE 1
+
+// Maximum items per transfer
+#define UDMA_MAX_TRANSFER 1024
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initUdma();
+void selectUdmaChannelEncoding(uint8_t channel, uint8_t encoding);
+void setUdmaChannelTransfer(uint8_t channel, uint8_t select, volatile const void* src,
+                            volatile void* dst, uint32_t control, uint16_t count);
+void setUdmaChannelBurstOnly(uint8_t channel, bool burstOnly);
+void selectUdmaChannelStructure(uint8_t channel, uint8_t select);
+uint8_t getUdmaChannelStructure(uint8_t channel);
+void enableUdmaChannel(uint8_t channel);
+void disableUdmaChannel(uint8_t channel);
+bool isUdmaChannelEnabled(uint8_t channel);
+bool isUdmaTransferDone(uint8_t channel, uint8_t select);
+uint16_t getUdmaTransferRemaining(uint8_t channel, uint8_t select);
+void requestUdmaChannel(uint8_t channel);
+bool isUdmaChannelInterrupt(uint8_t channel);
+void clearUdmaChannelInterrupt(uint8_t channel);
+
+#endif